@@ -124,7 +124,7 @@ namespace microgradpp{
         }
 
 
-        Tensor1D forward(Tensor1D input) override{
+        Tensor1D forward(TensorView input) override{
             return this->sequential(input);
         };
 
@@ -170,8 +170,9 @@ int main() {
     std::vector<float> vec(flatMat.begin<uint8_t>(), flatMat.end<uint8_t>());
 
     auto normVec = normalizeVector(vec);
-    Tensor2D input = normVec;
-    Tensor2D output = normVec;
+    // One row of pixels, loaded in bulk rather than one Value::create per pixel
+    Tensor2D input(normVec.data(), 1, normVec.size());
+    Tensor2D output(normVec.data(), 1, normVec.size());
 
     // MLP initialization
     auto mlp = std::make_unique<Example_Images>(newWidth , newHeight);
@@ -210,7 +211,7 @@ int main() {
         auto loss = lossFcn(output, ypred);
 
         mlp->zeroGrad();      // Zero gradients before backprop
-        loss->backProp();     // Backpropagate loss
+        loss->backPropParallel(); // Backpropagate loss; the 2500 output neurons run in parallel
         mlp->update();       // Update MLP weights
 
         ypred.reset();
@@ -0,0 +1,127 @@
+/**
+ *  @file memory.cpp
+ *  @brief Measures the memory footprint of the computational graph per node.
+ *
+ *  This file is part of the microgradpp project, a lightweight C++ library for neural
+ *  network training and inference.
+ *
+ *  @section License
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  @section Author
+ *  Gautam Sharma
+ *  Email: gautamsharma2813@gmail.com
+ *  Date: October 16, 2026
+ *
+ *  @details
+ *  Runs the image autoencoder topology of `images.cpp` (2500 -> 4 -> 2500) on synthetic
+ *  pixels and reports how many bytes the graph uses per node: the node itself, its tape
+ *  record, and the total arena + tape footprint divided by the number of nodes.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "TypeDefs.hpp"
+#include "Value.hpp"
+#include "Tensor.hpp"
+#include "base/BaseMultiLayerPerceptron.hpp"
+#include "nn/NeuralNet.hpp"
+#include "core/Sequential.hpp"
+#include "LossFunctions.hpp"
+
+namespace microgradpp {
+
+    using microgradpp::base::BaseMultiLayerPerceptron;
+    using microgradpp::core::Sequential;
+
+    class Example_Memory : public BaseMultiLayerPerceptron {
+    public:
+        explicit Example_Memory(size_t pixels) :
+                BaseMultiLayerPerceptron(Sequential(
+                        {
+                                nn::Linear(pixels, 4),
+                                nn::TanH(),
+                                nn::Linear(4, pixels)
+                        }))
+        {
+            this->learningRate = 0.00001;
+        }
+
+        Tensor1D forward(TensorView input) override {
+            return this->sequential(input);
+        }
+    };
+
+}
+
+int main() {
+    using microgradpp::Autograd;
+    using microgradpp::TapeEntry;
+    using microgradpp::Tensor2D;
+    using microgradpp::Value;
+    using microgradpp::loss::MeanSquaredErrorFor1DPixels;
+
+    constexpr size_t pixels = 50 * 50;
+    constexpr size_t numIterations = 5;
+
+    std::vector<float> image(pixels);
+    for (size_t idx = 0; idx < pixels; ++idx) {
+        image[idx] = 0.01f * std::sin(0.01f * static_cast<float>(idx));
+    }
+
+    Tensor2D input = image;
+    Tensor2D output = image;
+    Tensor2D ypred;
+
+    microgradpp::Example_Memory mlp(pixels);
+    MeanSquaredErrorFor1DPixels lossFcn;
+
+    auto& tape = Autograd::current();
+    double seconds = 0;
+
+    for (size_t idx = 0; idx < numIterations; ++idx) {
+        __MICROGRADPP_CLEAR__
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& inp : input) {
+            ypred.push_back(mlp(inp));
+        }
+        auto loss = lossFcn(output, ypred);
+        mlp.zeroGrad();
+        loss->backProp();
+        mlp.update();
+        seconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        printf("Iteration %zu loss %f\n", idx, loss->data);
+        ypred.reset();
+    }
+
+    const size_t nodes = tape.arena.size() + tape.pool.size();
+    const size_t graphBytes = tape.arena.capacity() * sizeof(Value) + tape.tape.capacity() * sizeof(TapeEntry);
+
+    printf("\n");
+    printf("sizeof(Value)            : %zu bytes\n", sizeof(Value));
+    printf("sizeof(TapeEntry)        : %zu bytes\n", sizeof(TapeEntry));
+    printf("nodes per iteration      : %u intermediate, %zu long-lived\n", tape.arena.size(), tape.pool.size());
+    printf("tape entries / iteration : %zu\n", tape.tape.size());
+    printf("graph bytes per node     : %.2f bytes\n", static_cast<double>(graphBytes) / static_cast<double>(tape.arena.size()));
+    printf("total bytes per node     : %.2f bytes (including long-lived nodes)\n",
+           static_cast<double>(graphBytes + tape.pool.size() * sizeof(Value)) / static_cast<double>(nodes));
+    printf("time per iteration       : %.3f ms\n", 1e3 * seconds / numIterations);
+
+    return 0;
+}
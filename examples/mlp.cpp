@@ -95,7 +95,7 @@ namespace microgradpp{
         }
 
 
-        Tensor1D forward(Tensor1D input) override{
+        Tensor1D forward(TensorView input) override{
             // Do anything else here
             return this->sequential(input);
         };
@@ -176,8 +176,12 @@ int main() {
      */
     auto mlp = std::make_unique<microgradpp::Example_MLP>();
 
-    // Initialize prediction Tensor
-    Tensor2D ypred;
+    // The graph is the same every iteration: capture it once and replay it
+    auto plan = mlp->capture(xs, ys, lossFcn);
+    plan.optimize();
+
+    // Replay as native code; the first run compiles and caches it, without a compiler the plan stays interpreted
+    plan.compile();
 
     // Start learning loop
     auto start = std::chrono::high_resolution_clock::now();
@@ -185,36 +189,23 @@ int main() {
     auto init =  getMemoryUsage();
 
     for (auto idx = 0; idx < numIterations; ++idx) {
-       __MICROGRADPP_CLEAR__
-
         auto initial_memory_usage = getMemoryUsage();
 
-        // Ensure the gradients of inputs is always zero
-        xs.zeroGrad();
-
-        auto a = xs.begin();
-        // Predict values
-        for (const auto &input: xs) {
-            ypred.push_back((*mlp)(input));
-        }
-
-        auto loss = lossFcn(ys, ypred);
+        // Predict values and compute the loss
+        auto loss = plan.forward(xs, ys);
 
         // Ensure all gradients are zero
         mlp->zeroGrad();
 
         // Perform backprop
-        loss->backProp();
+        plan.backward();
 
         // Update parameters
         mlp->update();
 
         std::cout << "Extra Memory usage: " << getMemoryUsage() - initial_memory_usage << " KB\n";
 
-        std::cout << "Iteration : " << idx << " " << "Loss: " << loss->data << "Extra Memory usage: " << getMemoryUsage() - initial_memory_usage << " KB\n";
-
-        // Reset prediction
-        ypred.reset();
+        std::cout << "Iteration : " << idx << " " << "Loss: " << loss << "Extra Memory usage: " << getMemoryUsage() - initial_memory_usage << " KB\n";
 
     }
 
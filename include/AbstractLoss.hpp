@@ -28,7 +28,7 @@
  *  This header file contains the definition of the AbstractLoss template class. This class
  *  serves as a base for creating various loss functions in neural networks. Any class
  *  derived from AbstractLoss must implement the `operator()` method, which takes two
- *  parameters of type T (representing ground truth and predictions) and returns a ValuePtr
+ *  parameters of type T (representing ground truth and predictions) and returns a ValueRef
  *  representing the calculated loss.
  */
 
@@ -54,6 +54,6 @@ namespace microgradpp {
          * @param prediction The predicted values.
          * @return A pointer to the calculated loss value.
          */
-        virtual ValuePtr operator()(const T& groundTruth, const T& prediction) = 0;
+        virtual typename T::ValueRef operator()(const T& groundTruth, const T& prediction) = 0;
     };
 }
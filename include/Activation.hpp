@@ -49,28 +49,38 @@ namespace microgradpp {
         SIGMOID  ///< Sigmoid function
     };
 
-    class Activation {
+    /**
+     * @brief Activation functions on nodes of scalar type S.
+     * @tparam S The scalar type of the nodes (see BasicValue).
+     */
+    template<class S>
+    class BasicActivation {
+        using Value = BasicValue<S>;
+        using ValueRef = BasicValueRef<S>;
+
         // Static functions for activation computations
-        static std::shared_ptr<Value> Relu(const std::shared_ptr<Value>& val) {
+        static ValueRef Relu(const ValueRef& val) {
             return Value::relu(val);
         }
 
-        static std::shared_ptr<Value> TanH(const std::shared_ptr<Value>& val) {
+        static ValueRef TanH(const ValueRef& val) {
             return Value::tanh(val);
         }
 
-        static std::shared_ptr<Value> Sigmoid(const std::shared_ptr<Value>& val) {
+        static ValueRef Sigmoid(const ValueRef& val) {
             return Value::sigmoid(val);
         }
 
     public:
         // Map of activation types to their corresponding functions
-        static inline std::unordered_map<ActivationType, std::function<std::shared_ptr<Value>(const std::shared_ptr<Value>&)>> mActivationFcn = {
+        static inline std::unordered_map<ActivationType, std::function<ValueRef(const ValueRef&)>> mActivationFcn = {
                 {ActivationType::RELU, Relu},
                 {ActivationType::TANH, TanH},
                 {ActivationType::SIGMOID, Sigmoid}
         };
     };
+
+    using Activation = BasicActivation<float>;
 }
 
 #endif // MICROGRADPP_ACTIVATION_HPP
@@ -0,0 +1,329 @@
+/**
+ *  @file Arena.hpp
+ *  @brief Defines the block allocators that back the nodes of the computational graph.
+ *
+ *  This file is part of the microgradpp project, a lightweight C++ library for neural
+ *  network training and inference.
+ *
+ *  @section License
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  @section Author
+ *  Gautam Sharma
+ *  Email: gautamsharma2813@gmail.com
+ *  Date: October 16, 2026
+ *
+ *  @details
+ *  Two allocators are provided. `NodeArena` is a bump allocator for the intermediate nodes
+ *  built during one training iteration; a single `clear()` releases all of them at once.
+ *  `NodePool` is a free-list allocator for long-lived nodes such as parameters and input
+ *  data, which must survive `Autograd::clear()` and are shared by every thread. Both hand
+ *  out memory in fixed-size blocks addressed by 32-bit indices, so node addresses stay
+ *  stable while the allocators grow.
+ */
+
+#pragma once
+
+// Standard libraries
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// microgradpp headers
+#include "TypeDefs.hpp"
+
+namespace microgradpp {
+
+    /**
+     * @brief Raw, correctly aligned storage for one object of type T.
+     */
+    template<class T>
+    struct alignas(T) NodeSlot {
+        unsigned char bytes[sizeof(T)];
+    };
+
+    /**
+     * @class NodeArena
+     * @brief Bump allocator for nodes that live until the next `clear()`.
+     *
+     * Nodes are addressed by a 32-bit index. Blocks are kept across `clear()` calls, so after
+     * the first iteration building a graph performs no heap allocations. Nodes are destroyed
+     * in bulk; when T is trivially destructible `clear()` only resets the bump cursor.
+     *
+     * @tparam T The node type.
+     * @tparam BlockSize Number of nodes per block (a power of two).
+     */
+    template<class T, uint32_t BlockSize = 4096>
+    class NodeArena {
+    public:
+        static constexpr uint32_t MAX_SIZE = 1u << 31; ///< Indices must leave the top bit free
+
+    private:
+        std::vector<std::unique_ptr<NodeSlot<T>[]>> _blocks; ///< Allocated blocks, reused after clear()
+        uint32_t _size = 0;                                   ///< Number of live nodes
+
+    public:
+        NodeArena() = default;
+        NodeArena(const NodeArena&) = delete;
+        NodeArena& operator=(const NodeArena&) = delete;
+
+        ~NodeArena() {
+            destroyAll();
+        }
+
+        /**
+         * @brief Constructs a new node at the bump cursor.
+         * @param args Arguments forwarded to the constructor of T.
+         * @return The index of the new node, valid until clear().
+         * @throws std::length_error If the arena already holds MAX_SIZE nodes.
+         */
+        template<class... Args>
+        uint32_t create(Args&&... args) {
+            if (_size == MAX_SIZE) {
+                throw std::length_error("Error in microgradpp::NodeArena -> too many intermediate nodes");
+            }
+            const uint32_t index = _size;
+            if (index / BlockSize == _blocks.size()) {
+                _blocks.emplace_back(new NodeSlot<T>[BlockSize]);
+            }
+            new (slot(index)) T(std::forward<Args>(args)...);
+            ++_size;
+            return index;
+        }
+
+        /**
+         * @brief Accesses a node by index.
+         * @param index An index returned by create().
+         * @return A reference to the node.
+         */
+        T& operator[](uint32_t index) {
+            return *reinterpret_cast<T*>(slot(index));
+        }
+
+        /**
+         * @brief Releases every node in the arena. Blocks are kept for reuse.
+         */
+        void clear() noexcept {
+            destroyAll();
+            _size = 0;
+        }
+
+        /**
+         * @brief Releases every node created after `size()` returned `mark`.
+         *
+         * Only valid when nothing refers to those nodes any more, e.g. the values
+         * computed by an inference pass that recorded no tape entries.
+         *
+         * @param mark A value previously returned by size().
+         */
+        void rewind(uint32_t mark) noexcept {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (uint32_t index = mark; index < _size; ++index) {
+                    (*this)[index].~T();
+                }
+            }
+            _size = mark;
+        }
+
+        /**
+         * @brief Returns the number of live nodes.
+         */
+        __MICROGRADPP_NO_DISCARD__
+        uint32_t size() const {
+            return _size;
+        }
+
+        /**
+         * @brief Returns the number of nodes the arena can hold without allocating.
+         */
+        __MICROGRADPP_NO_DISCARD__
+        size_t capacity() const {
+            return _blocks.size() * BlockSize;
+        }
+
+    private:
+        unsigned char* slot(uint32_t index) const {
+            return _blocks[index / BlockSize][index % BlockSize].bytes;
+        }
+
+        void destroyAll() noexcept {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (uint32_t index = 0; index < _size; ++index) {
+                    (*this)[index].~T();
+                }
+            }
+        }
+    };
+
+    /**
+     * @class NodePool
+     * @brief Thread-safe free-list allocator for long-lived nodes.
+     *
+     * Nodes are addressed by a 32-bit index. The pool is shared by all threads: create() and
+     * release() take a lock, while operator[] does not. Blocks are reached through a fixed-size
+     * directory whose entries are written once, before any index into the block is handed out,
+     * so a lookup never races with the growth of the pool. Released slots are recycled by later
+     * allocations, so creating and dropping parameters or input data does not grow the pool.
+     * Deferring the reuse of a slot until no tape refers to it is the caller's job (see
+     * `BasicAutograd::releasePersistent()`).
+     *
+     * @tparam T The node type.
+     * @tparam BlockSize Number of nodes per block (a power of two).
+     * @tparam MaxBlocks Size of the block directory; the pool holds at most BlockSize * MaxBlocks nodes.
+     */
+    template<class T, uint32_t BlockSize = 1024, uint32_t MaxBlocks = 65536>
+    class NodePool {
+        static_assert(uint64_t(BlockSize) * MaxBlocks <= (1ull << 31), "pool indices must leave the top bit free");
+    private:
+        NodeSlot<T>* _directory[MaxBlocks] = {};                ///< Block of each directory entry
+        std::vector<std::unique_ptr<NodeSlot<T>[]>> _blocks;     ///< Allocated blocks
+        uint32_t _used = 0;                                       ///< Number of slots ever handed out
+        std::vector<uint32_t> _free;                              ///< Released slots ready for reuse
+        mutable std::mutex _mutex;                                ///< Guards everything but lookups
+
+    public:
+        NodePool() = default;
+        NodePool(const NodePool&) = delete;
+        NodePool& operator=(const NodePool&) = delete;
+
+        /**
+         * @brief Constructs a new node, reusing a released slot when one is available.
+         * @param args Arguments forwarded to the constructor of T.
+         * @return The index of the new node, valid until it is released.
+         * @throws std::length_error If the pool is full.
+         */
+        template<class... Args>
+        uint32_t create(Args&&... args) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            uint32_t index;
+            if (!_free.empty()) {
+                index = _free.back();
+                _free.pop_back();
+            } else {
+                if (_used == BlockSize * MaxBlocks) {
+                    throw std::length_error("Error in microgradpp::NodePool -> too many long-lived nodes");
+                }
+                if (_used / BlockSize == _blocks.size()) {
+                    // One free-list entry per slot, so release() never allocates
+                    _free.reserve(static_cast<size_t>(_blocks.size() + 1) * BlockSize);
+                    _blocks.emplace_back(new NodeSlot<T>[BlockSize]);
+                    _directory[_used / BlockSize] = _blocks.back().get();
+                }
+                index = _used++;
+            }
+            new (slot(index)) T(std::forward<Args>(args)...);
+            return index;
+        }
+
+        /**
+         * @brief Constructs `count` nodes from `data` in consecutive slots, under one lock.
+         *
+         * The slots are taken past every slot handed out so far, never from released ones,
+         * so the nodes get the indices first, first + 1, ... and can be released one by one.
+         * @param data One constructor argument per node.
+         * @param count The number of nodes.
+         * @return The index of the first node.
+         * @throws std::length_error If the pool cannot hold `count` more nodes.
+         */
+        template<class U>
+        uint32_t createRange(const U* data, uint32_t count) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (count > BlockSize * MaxBlocks - _used) {
+                throw std::length_error("Error in microgradpp::NodePool -> too many long-lived nodes");
+            }
+            const uint32_t first = _used;
+            const size_t blocks = (static_cast<size_t>(first) + count + BlockSize - 1) / BlockSize;
+            if (blocks > _blocks.size()) {
+                _free.reserve(blocks * BlockSize);
+                _blocks.reserve(blocks);
+                while (_blocks.size() < blocks) {
+                    _blocks.emplace_back(new NodeSlot<T>[BlockSize]);
+                    _directory[_blocks.size() - 1] = _blocks.back().get();
+                }
+            }
+            for (uint32_t idx = 0; idx < count; ++idx) {
+                new (slot(first + idx)) T(data[idx]);
+            }
+            _used += count;
+            return first;
+        }
+
+        /**
+         * @brief Accesses a node by index.
+         * @param index An index returned by create().
+         * @return A reference to the node.
+         */
+        T& operator[](uint32_t index) {
+            return *reinterpret_cast<T*>(slot(index));
+        }
+
+        /**
+         * @brief Destroys released nodes and makes their slots available again.
+         *
+         * Never allocates: the free list has room for every slot of the allocated blocks.
+         * Slots released in ascending order at the end of the pool (e.g. a range) are given
+         * back to the bump cursor, so later ranges can reuse them.
+         * @param indices Indices returned by create(), each released once.
+         */
+        void release(const std::vector<uint32_t>& indices) noexcept {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const uint32_t index : indices) {
+                (*this)[index].~T();
+                _free.push_back(index);
+            }
+            trim();
+        }
+
+        /**
+         * @brief Destroys a released node and makes its slot available again.
+         * @param index An index returned by create(), released once.
+         */
+        void release(uint32_t index) noexcept {
+            std::lock_guard<std::mutex> lock(_mutex);
+            (*this)[index].~T();
+            _free.push_back(index);
+            trim();
+        }
+
+        /**
+         * @brief Returns the number of nodes that have not been released.
+         */
+        __MICROGRADPP_NO_DISCARD__
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _used - _free.size();
+        }
+
+    private:
+        unsigned char* slot(uint32_t index) const {
+            return _directory[index / BlockSize][index % BlockSize].bytes;
+        }
+
+        /**
+         * @brief Moves the bump cursor back over the most recently freed slots at its end.
+         */
+        void trim() noexcept {
+            while (!_free.empty() && _free.back() + 1 == _used) {
+                _free.pop_back();
+                --_used;
+            }
+        }
+    };
+}
@@ -32,56 +32,1237 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
+#include <memory>
+#include <cstdint>
+#include <cmath>
+#include <atomic>
+#include <cstring>
 #include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#ifdef MICROGRADPP_DEBUG_METADATA
+#include <string>
 #include <unordered_map>
+#endif
+
+// Third-party libraries
+#include <tbb/blocked_range.h>
+#include <tbb/combinable.h>
+#include <tbb/parallel_for.h>
+
+// m++ headers
+#include "Arena.hpp"
+#include "Scalar.hpp"
 
 namespace microgradpp{
-    class Value;
-    using ValuePtr = std::shared_ptr<Value>;
+    template<class S> class BasicValue;
+    using Value = BasicValue<float>;
+
+    /**
+     * @brief Operation codes recorded on the tape.
+     *
+     * Each code selects one backward rule in `BasicAutograd::backward()`.
+     */
+    enum class OpCode : uint8_t {
+        ADD,        ///< out = lhs + rhs
+        SUBTRACT,   ///< out = lhs - rhs
+        MULTIPLY,   ///< out = lhs * rhs
+        ADD_CONST,  ///< out = lhs + aux, the constant has no node
+        MUL_CONST,  ///< out = lhs * aux, the constant has no node
+        POW,        ///< out = lhs ^ aux
+        TANH,       ///< out = tanh(lhs), aux caches the output
+        RELU,       ///< out = max(0, lhs)
+        SIGMOID,    ///< out = sigmoid(lhs), aux caches the output
+        DOT,        ///< out = sum(w[i] * x[i]) + bias, operands in the tape's operand buffer
+        SUM,        ///< out = sum(x[i]), operands in the tape's operand buffer
+        FUSED,      ///< out = f(x[i]) for a fused expression, see `FusedKernel`
+        RELU_MASK,  ///< out[i] = max(0, x[i]) for a whole layer, backward reads a bit mask
+        CHECKPOINT, ///< Outputs of a segment recomputed during backward, see `Checkpoint`
+        TENSOR,     ///< An operation on dense tensors, see `TensorOp`
+        LEAF        ///< Not produced by an operation (parameter, input or constant)
+    };
+
+    /**
+     * @brief A single plain record on the computation tape.
+     *
+     * Operands are 32-bit node indices into the tape's storage (see `BasicAutograd::node`).
+     * For n-ary operations (DOT, SUM), `lhs` is an offset into the operand buffer and `rhs`
+     * the number of terms; for DOT the buffer then holds the n weights, the n inputs and the
+     * bias, for SUM the n terms. For FUSED, `rhs` is the id of the kernel and the buffer holds
+     * its node operands followed by its constants (as float bits). RELU_MASK has n outputs:
+     * the buffer holds the n inputs, the n outputs and one bit per output (set if it is
+     * positive) packed into 32-bit words; `out` is the first output.
+     * Intermediate nodes live in the arena; long-lived nodes released while the tape still
+     * refers to them are only reclaimed by `clear()`.
+     *
+     * @tparam C The arithmetic type of the nodes (see ScalarTraits).
+     */
+    template<class C>
+    struct BasicTapeEntry {
+        OpCode op;              ///< Operation that produced `out`
+        uint32_t out;           ///< Output node of the operation
+        uint32_t lhs;           ///< First operand (operand offset for DOT, SUM, FUSED and RELU_MASK)
+        uint32_t rhs;           ///< Second operand (unused for unary ops, term count for DOT, SUM and RELU_MASK, kernel for FUSED)
+        C aux = 0;              ///< Scalar operand or cached result (constant, exponent, tanh/sigmoid output)
+    };
+
+    using TapeEntry = BasicTapeEntry<float>;
+
+    /**
+     * @brief Value and backward rule of an expression evaluated as a single record (FUSED).
+     *
+     * Kernels work on plain arrays: the values of the record's node operands and its constants,
+     * in the order they are stored in the operand buffer. `backward` writes the gradient with
+     * respect to every operand into `grads`; the tape accumulates them into the nodes.
+     * Kernels compute in float.
+     */
+    struct FusedKernel {
+        static constexpr uint32_t MAX_OPERANDS = 32;   ///< Most node operands (and constants) of one kernel
+
+        uint32_t operands = 0;   ///< Number of node operands
+        uint32_t constants = 0;  ///< Number of constants stored after them
+        float (*forward)(const float* values, const float* constants) = nullptr;
+        void (*backward)(const float* values, const float* constants, float grad, float* grads) = nullptr;
+
+        /**
+         * @brief Registers a kernel and returns its id. Ids are never reused.
+         * @throws std::length_error If too many kernels were registered.
+         */
+        static uint32_t add(const FusedKernel& kernel) {
+            const uint32_t id = count().fetch_add(1);
+            if (id >= CAPACITY) {
+                throw std::length_error("Error in microgradpp::FusedKernel -> too many fused expressions");
+            }
+            table()[id] = kernel;
+            return id;
+        }
+
+        /**
+         * @brief Returns a registered kernel.
+         * @param id An id returned by add().
+         */
+        static const FusedKernel& get(uint32_t id) {
+            return table()[id];
+        }
+
+    private:
+        static constexpr uint32_t CAPACITY = 4096;
+
+        static FusedKernel* table() {
+            static FusedKernel kernels[CAPACITY];
+            return kernels;
+        }
+
+        static std::atomic<uint32_t>& count() {
+            static std::atomic<uint32_t> value{0};
+            return value;
+        }
+    };
+
+    /**
+     * @brief A segment of the forward pass whose inner nodes are recomputed during backward.
+     *
+     * Only the segment's inputs and outputs are kept in the graph. When the backward pass
+     * reaches the segment, `recompute` rebuilds it from the inputs with recording enabled,
+     * the gradients of the kept outputs are copied onto the rebuilt ones and the rebuilt
+     * records are differentiated, after which they are discarded again.
+     */
+    struct Checkpoint {
+        std::vector<uint32_t> inputs;   ///< Segment inputs
+        std::vector<uint32_t> outputs;  ///< Kept segment outputs (CHECKPOINT nodes)
+        std::function<std::vector<uint32_t>(const std::vector<uint32_t>&)> recompute; ///< Rebuilds the segment, returns its outputs
+    };
+
+    /**
+     * @brief An operation on whole dense tensors (see DenseTensor), recorded as one tape entry.
+     *
+     * The tensors keep their gradients in their own buffers, so the record only holds the
+     * closure that adds the output gradients into the input gradients. Conversions between
+     * dense tensors and nodes also list the nodes they read or create, which lets the pruned
+     * backward pass follow gradients across the boundary. An operation without `outputs`
+     * runs whenever the backward pass gets to it.
+     */
+    struct TensorOp {
+        std::vector<uint32_t> inputs;   ///< Nodes read by the operation
+        std::vector<uint32_t> outputs;  ///< Nodes written by the operation (TENSOR nodes)
+        std::function<void()> backward; ///< Adds the operation's gradients into its inputs
+    };
+
+    /**
+     * @brief Sizes of a tape's buffers at some point, to discard everything recorded after it.
+     */
+    struct TapePosition {
+        size_t records = 0;     ///< Size of the tape
+        size_t operands = 0;    ///< Size of the operand buffer
+        size_t checkpoints = 0; ///< Number of checkpointed segments
+        size_t tensorOps = 0;   ///< Number of dense tensor operations
+        uint32_t nodes = 0;     ///< Size of the arena
+    };
+
+    /**
+     * @brief Work done by the last backward pass of a tape.
+     *
+     * A record whose output gradient is zero, or a ReLU whose output is zero, adds nothing
+     * to its operands; the backward pass skips it without touching the operands. The pruned
+     * pass (`backward(root)`) then does not reach the records that produced those operands
+     * either, unless another path leads to them, so a dead ReLU unit skips the whole dot
+     * product feeding it.
+     */
+    struct BackwardStats {
+        size_t executed = 0;        ///< Records whose backward rule ran
+        size_t skipped = 0;         ///< Records skipped because all their contributions were zero
+        size_t skippedOperands = 0; ///< Operand gradient updates the skipped records did not do
+    };
+
+#ifdef MICROGRADPP_DEBUG_METADATA
+    /**
+     * @brief Debug information about a node, kept out of the node itself.
+     */
+    struct NodeMetadata {
+        size_t id = 0;                  ///< Unique identifier of the node
+        std::string label;              ///< Optional user label
+        std::vector<uint32_t> prev;     ///< Operands the node was computed from
+    };
+#endif
+
+    /**
+     * @brief Storage and arithmetic types of a node type.
+     */
+    template<class T>
+    struct NodeTraits;
+
+    template<class S>
+    struct NodeTraits<BasicValue<S>> {
+        using Scalar = S;                                       ///< Type of the stored data and gradient
+        using Compute = typename ScalarTraits<S>::Compute;      ///< Type the operations compute in
+        static constexpr bool forwardMode = ScalarTraits<S>::forwardMode; ///< Derivatives travel with the values
+    };
 
-    // TapeEntry
-    struct TapeEntry {
-        ValuePtr output;                          // The output of the operation
-        std::function<void()> backward_fn = nullptr;        // Function to compute gradients during backward pass
+    /**
+     * @brief Tape recording switch of the calling thread, shared by the tapes of every node type.
+     */
+    struct GradMode {
+        static inline thread_local bool enabled = true; ///< See NoGradGuard
     };
 
-    class Autograd {
+    /**
+     * @brief Records operations and replays them in reverse to compute gradients.
+     *
+     * Operations are recorded on the calling thread's current tape (see `current()`). Each
+     * thread starts out with a default tape of its own, and a `TapeScope` switches the thread
+     * to an explicitly created tape, so independent graphs can be built and differentiated
+     * concurrently. Long-lived nodes live in a pool shared by all threads, which lets the
+     * threads read the same parameters; gradients of shared nodes are accumulated without
+     * synchronisation, so backward passes that reach the same parameters must not run at the
+     * same time. Intermediate nodes belong to the tape that created them.
+     *
+     * The tape is parameterised on the node type because this header is included
+     * by Value.hpp before `Value` is complete; the backward loop is instantiated
+     * where it is used. Each node type (`BasicValue<S>` for a scalar type S) has its own
+     * tapes and pool.
+     *
+     * @tparam T The node type (Value).
+     */
+    template<class T>
+    class BasicAutograd {
     public:
-        Autograd() = default;
+        using Compute = typename NodeTraits<T>::Compute;  // Arithmetic type of the nodes
+        using Entry = BasicTapeEntry<Compute>;            // Record type of the tape
 
-        std::vector<TapeEntry> tape;              // Stores the sequence of operations
-        std::unordered_map<size_t, std::function<void()>> TapeMap;
+        BasicAutograd() = default;
+
+        ~BasicAutograd() {
+            if (active() == this) {
+                active() = nullptr;
+            }
+            pool.release(retired);
+        }
+
+        BasicAutograd(const BasicAutograd&) = delete;
+        BasicAutograd& operator=(const BasicAutograd&) = delete;
+
+        static constexpr uint32_t PERSISTENT = 1u << 31;  // Index tag for nodes owned by the pool
+        static constexpr uint32_t NONE = ~0u;             // Index of no node
+
+        std::vector<Entry> tape;                  // Stores the sequence of operations
+        std::vector<uint32_t> operands;           // Operand lists of n-ary operations
+        std::vector<Checkpoint> checkpoints;      // Segments recomputed during backward
+        std::vector<TensorOp> tensorOps;          // Dense tensor operations
+        NodeArena<T> arena;                       // Intermediate nodes, released together by clear()
+        std::vector<uint32_t> retired;            // Long-lived nodes released since the last clear()
+        std::vector<uint32_t> levels;             // Scratch for backwardParallel(): level of each intermediate node
+        std::vector<std::pair<uint32_t, uint32_t>> schedule; // Scratch for backwardParallel(): (level, record)
+        std::vector<uint32_t> order;              // Scratch for backwardParallel(): records sorted by level
+        std::vector<uint32_t>* captured = nullptr; // Set while a GraphPlan captures; receives the nodes it owns
+        BackwardStats stats;                      // Work done by the last backward pass
+#ifdef MICROGRADPP_DEBUG_METADATA
+        std::unordered_map<uint32_t, NodeMetadata> metadata;  // Debug side table keyed by node index
+#endif
+
+        /**
+         * @brief Resolves a node index to the node it refers to.
+         * @param index An index returned by createNode() or createPersistent().
+         * @return A reference to the node.
+         */
+        T& node(uint32_t index) {
+            return (index & PERSISTENT) ? pool[index & ~PERSISTENT] : arena[index];
+        }
+
+        /**
+         * @brief Returns true for records whose operands are in the operand buffer (DOT, SUM, FUSED, RELU_MASK).
+         */
+        static bool isNary(const Entry& entry) {
+            return entry.op == OpCode::DOT || entry.op == OpCode::SUM || entry.op == OpCode::FUSED
+                   || entry.op == OpCode::RELU_MASK;
+        }
+
+        /**
+         * @brief Returns the number of node operands an n-ary record keeps in the operand buffer.
+         */
+        static uint32_t operandCount(const Entry& entry) {
+            switch (entry.op) {
+                case OpCode::DOT:
+                    return 2 * entry.rhs + 1;
+                case OpCode::FUSED:
+                    return FusedKernel::get(entry.rhs).operands;
+                default:
+                    return entry.rhs;
+            }
+        }
+
+        /**
+         * @brief Returns the number of slots an n-ary record takes in the operand buffer:
+         * its node operands plus, for FUSED, its constants and, for RELU_MASK, its outputs
+         * and mask words.
+         */
+        static uint32_t operandSlots(const Entry& entry) {
+            switch (entry.op) {
+                case OpCode::FUSED:
+                    return operandCount(entry) + FusedKernel::get(entry.rhs).constants;
+                case OpCode::RELU_MASK:
+                    return 2 * entry.rhs + maskWords(entry.rhs);
+                default:
+                    return operandCount(entry);
+            }
+        }
+
+        /**
+         * @brief Returns the number of 32-bit words holding a mask of n bits.
+         */
+        static uint32_t maskWords(uint32_t n) {
+            return (n + 31) / 32;
+        }
 
         /**
-         * @brief Adds an operation to the computation tape.
+         * @brief Constructs an intermediate node that lives until the next clear().
          *
+         * While a GraphPlan is capturing, the node is taken from the pool instead and
+         * handed to the plan, so it survives clear().
+         * @param args Arguments forwarded to the constructor of T.
+         * @return The index of the new node.
+         */
+        template<class... Args>
+        uint32_t createNode(Args&&... args) {
+            if (captured) {
+                const uint32_t index = createPersistent(std::forward<Args>(args)...);
+                captured->push_back(index);
+                return index;
+            }
+            const uint32_t index = arena.create(std::forward<Args>(args)...);
+            arena[index].index = index;
+#ifdef MICROGRADPP_DEBUG_METADATA
+            metadata[index] = {T::generateID()};
+#endif
+            return index;
+        }
+
+        /**
+         * @brief Constructs a long-lived node that survives clear().
+         * @param args Arguments forwarded to the constructor of T.
+         * @return The index of the new node, tagged with PERSISTENT.
+         */
+        template<class... Args>
+        uint32_t createPersistent(Args&&... args) {
+            reserveRetired(1);
+            const uint32_t index = pool.create(std::forward<Args>(args)...) | PERSISTENT;
+            node(index).index = index;
+#ifdef MICROGRADPP_DEBUG_METADATA
+            metadata[index] = {T::generateID()};
+#endif
+            return index;
+        }
+
+        /**
+         * @brief Constructs `count` long-lived nodes from `data` with consecutive indices.
+         *
+         * The pool is locked once for all of them (see NodePool::createRange()).
+         * @param data The node values, in order.
+         * @param count The number of nodes.
+         * @return The index of the first node, tagged with PERSISTENT.
+         */
+        template<class U>
+        uint32_t createPersistentRange(const U* data, uint32_t count) {
+            reserveRetired(count);
+            const uint32_t first = pool.createRange(data, count) | PERSISTENT;
+            for (uint32_t idx = 0; idx < count; ++idx) {
+                node(first + idx).index = first + idx;
+#ifdef MICROGRADPP_DEBUG_METADATA
+                metadata[first + idx] = {T::generateID()};
+#endif
+            }
+            return first;
+        }
+
+        /**
+         * @brief Makes room in `retired` for every live long-lived node plus `count` new ones,
+         * so releasing them never allocates.
+         */
+        void reserveRetired(size_t count) {
+            const size_t needed = pool.size() + count;
+            if (retired.capacity() < needed) {
+                retired.reserve(std::max(needed, 2 * retired.capacity()));
+            }
+        }
+
+        /**
+         * @brief Gives a long-lived node back to the pool.
+         *
+         * The node stays valid until the next clear() of the calling thread's current tape,
+         * so records of that tape can still reach it. Called from destructors, so it never
+         * throws: createPersistent() keeps room in `retired` for every live node, and should
+         * a node released on another thread's tape not fit, it is kept rather than reused early.
+         * @param index An index returned by createPersistent().
+         */
+        static void releasePersistent(uint32_t index) noexcept {
+            BasicAutograd* tape = active();
+            if (!tape) {
+                // No tape on this thread (not used yet, or already destroyed): nothing refers to it
+                pool.release(index & ~PERSISTENT);
+                return;
+            }
+            try {
+                tape->retired.push_back(index & ~PERSISTENT);
+            } catch (...) {
+                return;
+            }
+#ifdef MICROGRADPP_DEBUG_METADATA
+            tape->metadata.erase(index);
+#endif
+        }
+
+        /**
+         * @brief Adds an operation to the computation tape. Does nothing in inference mode.
+         *
+         * @param op The operation that produced the output.
          * @param output The output of the operation to be recorded.
-         * @param backward_fn The function to compute gradients during the backward pass.
+         * @param lhs The first operand.
+         * @param rhs The second operand (NONE for unary operations).
+         * @param aux A scalar cached for the backward rule.
+         */
+        void add_entry(OpCode op, uint32_t output, uint32_t lhs, uint32_t rhs = NONE, Compute aux = 0) {
+            if (!isGradEnabled()) {
+                return;
+            }
+            tape.push_back({op, output, lhs, rhs, aux});
+#ifdef MICROGRADPP_DEBUG_METADATA
+            auto& prev = metadata[output].prev;
+            if (op == OpCode::DOT || op == OpCode::FUSED) {
+                const Entry& entry = tape.back();
+                prev.assign(operands.begin() + lhs, operands.begin() + lhs + operandCount(entry));
+                return;
+            }
+            prev.assign({lhs});
+            if (rhs != NONE) {
+                prev.push_back(rhs);
+            }
+#endif
+        }
+
+        /**
+         * @brief Adds a dot product `out = sum(weights[i] * inputs[i]) + bias` to the tape.
+         * Does nothing in inference mode.
+         *
+         * @param output The output of the operation.
+         * @param weights Indices of the n weights.
+         * @param inputs Indices of the n inputs.
+         * @param n Number of terms.
+         * @param bias Index of the bias.
+         */
+        void add_dot_entry(uint32_t output, const uint32_t* weights, const uint32_t* inputs, uint32_t n, uint32_t bias) {
+            if (!isGradEnabled()) {
+                return;
+            }
+            const auto offset = static_cast<uint32_t>(operands.size());
+            operands.insert(operands.end(), weights, weights + n);
+            operands.insert(operands.end(), inputs, inputs + n);
+            operands.push_back(bias);
+            add_entry(OpCode::DOT, output, offset, n);
+        }
+
+        /**
+         * @brief Adds a fused expression to the tape. Does nothing in inference mode.
+         *
+         * @param output The output of the expression.
+         * @param kernel Id of the expression's FusedKernel.
+         * @param nodes Indices of the kernel's node operands.
+         * @param constants The kernel's constants.
+         */
+        void add_fused_entry(uint32_t output, uint32_t kernel, const uint32_t* nodes, const float* constants) {
+            if (!isGradEnabled()) {
+                return;
+            }
+            const FusedKernel& fused = FusedKernel::get(kernel);
+            const auto offset = static_cast<uint32_t>(operands.size());
+            operands.insert(operands.end(), nodes, nodes + fused.operands);
+            operands.resize(offset + fused.operands + fused.constants);
+            if (fused.constants) {
+                std::memcpy(operands.data() + offset + fused.operands, constants, fused.constants * sizeof(float));
+            }
+            add_entry(OpCode::FUSED, output, offset, kernel);
+        }
+
+        /**
+         * @brief Adds a ReLU over n values to the tape as one record. Does nothing in
+         * inference mode.
+         *
+         * Only one bit per element is saved for backward, whether the output is positive,
+         * so the backward rule never reads the outputs' values.
+         *
+         * @param inputs Indices of the n inputs.
+         * @param outputs Indices of the n outputs, already holding max(0, input).
+         * @param n Number of elements.
+         */
+        void add_relu_mask_entry(const uint32_t* inputs, const uint32_t* outputs, uint32_t n) {
+            if (!isGradEnabled() || n == 0) {
+                return;
+            }
+            const auto offset = static_cast<uint32_t>(operands.size());
+            operands.insert(operands.end(), inputs, inputs + n);
+            operands.insert(operands.end(), outputs, outputs + n);
+            operands.resize(offset + 2 * n + maskWords(n), 0);
+            uint32_t* mask = operands.data() + offset + 2 * n;
+            for (uint32_t idx = 0; idx < n; ++idx) {
+                mask[idx / 32] |= static_cast<uint32_t>(node(outputs[idx]).data > 0) << (idx % 32);
+            }
+            tape.push_back({OpCode::RELU_MASK, outputs[0], offset, n, 0});
+#ifdef MICROGRADPP_DEBUG_METADATA
+            for (uint32_t idx = 0; idx < n; ++idx) {
+                metadata[outputs[idx]].prev.assign({inputs[idx]});
+            }
+#endif
+        }
+
+        /**
+         * @brief Records a checkpointed segment. Does nothing in inference mode.
+         *
+         * @param checkpoint The segment; its outputs must be CHECKPOINT nodes.
+         */
+        void add_checkpoint(Checkpoint checkpoint) {
+            if (!isGradEnabled()) {
+                return;
+            }
+            const auto id = static_cast<uint32_t>(checkpoints.size());
+            const uint32_t first = checkpoint.outputs.empty() ? NONE : checkpoint.outputs.front();
+            checkpoints.push_back(std::move(checkpoint));
+            tape.push_back({OpCode::CHECKPOINT, first, id, NONE, 0});
+        }
+
+        /**
+         * @brief Records an operation on dense tensors. Does nothing in inference mode.
+         *
+         * @param op The operation; its outputs, if any, must be TENSOR nodes.
          */
-        void add_entry(ValuePtr& output, std::function<void()> backward_fn) {
-            tape.push_back({output, std::move(backward_fn)});
+        void add_tensor_op(TensorOp op) {
+            if (!isGradEnabled()) {
+                return;
+            }
+            const auto id = static_cast<uint32_t>(tensorOps.size());
+            const uint32_t first = op.outputs.empty() ? NONE : op.outputs.front();
+            tensorOps.push_back(std::move(op));
+            tape.push_back({OpCode::TENSOR, first, id, NONE, 0});
         }
 
         /**
          * @brief Performs a backward pass through the computation tape,
-         * executing the stored backward functions in reverse order.
+         * applying the backward rule of each record in reverse order.
          */
         void backward() {
-            for (auto it = global_tape.tape.rbegin(); it != global_tape.tape.rend(); ++it) {
-                if (it->backward_fn) {
-                    it->backward_fn();
+            backward(tape, operands);
+        }
+
+        /**
+         * @brief Re-evaluates recorded operations in order from the current values of their operands.
+         *
+         * Used to replay a captured graph with new inputs. Cached scalars (tanh/sigmoid
+         * outputs, ReLU masks) are refreshed in place.
+         *
+         * @param entries The records to evaluate.
+         * @param args The operand buffer the n-ary records refer to.
+         */
+        void forward(std::vector<Entry>& entries, std::vector<uint32_t>& args) {
+            for (auto& entry : entries) {
+                if (entry.op == OpCode::CHECKPOINT || entry.op == OpCode::TENSOR) {
+                    continue; // Plans are captured without checkpointing or dense tensors
+                }
+                auto& out = node(entry.out).data;
+                if (entry.op == OpCode::DOT) {
+                    const uint32_t* weights = args.data() + entry.lhs;
+                    const uint32_t* inputs = weights + entry.rhs;
+                    Compute sum = 0;
+                    for (uint32_t idx = 0; idx < entry.rhs; ++idx) {
+                        sum += node(inputs[idx]).data * node(weights[idx]).data;
+                    }
+                    out = sum + node(inputs[entry.rhs]).data;
+                    continue;
+                }
+                if (entry.op == OpCode::SUM) {
+                    const uint32_t* terms = args.data() + entry.lhs;
+                    Compute sum = 0;
+                    for (uint32_t idx = 0; idx < entry.rhs; ++idx) {
+                        sum += node(terms[idx]).data;
+                    }
+                    out = sum;
+                    continue;
+                }
+                if (entry.op == OpCode::FUSED) {
+                    const FusedKernel& kernel = FusedKernel::get(entry.rhs);
+                    float values[FusedKernel::MAX_OPERANDS];
+                    float constants[FusedKernel::MAX_OPERANDS];
+                    gather(kernel, args.data() + entry.lhs, values, constants);
+                    out = static_cast<Compute>(kernel.forward(values, constants));
+                    continue;
+                }
+                if (entry.op == OpCode::RELU_MASK) {
+                    const uint32_t* inputs = args.data() + entry.lhs;
+                    const uint32_t* outputs = inputs + entry.rhs;
+                    uint32_t* mask = args.data() + entry.lhs + 2 * entry.rhs;
+                    std::fill(mask, mask + maskWords(entry.rhs), 0u);
+                    for (uint32_t idx = 0; idx < entry.rhs; ++idx) {
+                        const Compute value = std::max<Compute>(0, node(inputs[idx]).data);
+                        node(outputs[idx]).data = value;
+                        mask[idx / 32] |= static_cast<uint32_t>(value > 0) << (idx % 32);
+                    }
+                    continue;
+                }
+                const Compute lhs = node(entry.lhs).data;
+                switch (entry.op) {
+                    case OpCode::ADD:
+                        out = lhs + node(entry.rhs).data;
+                        break;
+                    case OpCode::SUBTRACT:
+                        out = lhs - node(entry.rhs).data;
+                        break;
+                    case OpCode::MULTIPLY:
+                        out = lhs * node(entry.rhs).data;
+                        break;
+                    case OpCode::ADD_CONST:
+                        out = lhs + entry.aux;
+                        break;
+                    case OpCode::MUL_CONST:
+                        out = lhs * entry.aux;
+                        break;
+                    case OpCode::POW:
+                        out = std::pow(lhs, entry.aux);
+                        break;
+                    case OpCode::TANH:
+                        out = entry.aux = (std::exp(2 * lhs) - 1) / (std::exp(2 * lhs) + 1);
+                        break;
+                    case OpCode::RELU:
+                        out = std::max<Compute>(0, lhs);
+                        break;
+                    case OpCode::SIGMOID:
+                        out = entry.aux = std::exp(lhs) / (1 + std::exp(lhs));
+                        break;
+                    case OpCode::DOT:
+                    case OpCode::SUM:
+                    case OpCode::FUSED:
+                    case OpCode::RELU_MASK:
+                    case OpCode::CHECKPOINT:
+                    case OpCode::TENSOR:
+                    case OpCode::LEAF:
+                        break;
+                }
+            }
+        }
+
+        /**
+         * @brief Applies the backward rule of each record in reverse order.
+         * @param entries The records to differentiate, in the order they were recorded.
+         * @param args The operand buffer the n-ary records refer to.
+         */
+        void backward(const std::vector<Entry>& entries, const std::vector<uint32_t>& args) {
+            stats = {};
+            // Indexed walk: recomputing a checkpoint appends to (and reallocates) the tape
+            for (size_t pos = entries.size(); pos-- > 0;) {
+                count(Entry(entries[pos]), args, stats);
+            }
+        }
+
+        /**
+         * @brief Back-propagates from `root` through the records it depends on only.
+         *
+         * Walking the tape in reverse, a record runs only if its output was reached from
+         * the root; its operands are then marked as reached. Records of side computations
+         * that do not feed the root are skipped. A reached record that contributes nothing
+         * (see BackwardStats) does not mark its operands. Marks live in the node flags and
+         * are cleared as the walk passes them, so no extra storage is needed.
+         *
+         * @param root The node whose gradient has been seeded.
+         */
+        void backward(uint32_t root) {
+            stats = {};
+            mark(root);
+            // Indexed walk: recomputing a checkpoint appends to (and reallocates) the tape
+            for (size_t pos = tape.size(); pos-- > 0;) {
+                const Entry entry = tape[pos];
+                if (!reached(entry)) {
+                    continue;
+                }
+                if (!count(entry, operands, stats)) {
+                    continue;
+                }
+                if (entry.op == OpCode::RELU_MASK) {
+                    // Inputs of the zeroed elements received nothing
+                    const uint32_t* inputs = operands.data() + entry.lhs;
+                    const uint32_t* mask = inputs + 2 * entry.rhs;
+                    for (uint32_t idx = 0; idx < entry.rhs; ++idx) {
+                        if ((mask[idx / 32] >> (idx % 32)) & 1u) {
+                            mark(inputs[idx]);
+                        }
+                    }
+                } else if (isNary(entry)) {
+                    const uint32_t* args = operands.data() + entry.lhs;
+                    for (uint32_t idx = 0; idx < operandCount(entry); ++idx) {
+                        mark(args[idx]);
+                    }
+                } else if (entry.op == OpCode::CHECKPOINT) {
+                    for (const uint32_t input : checkpoints[entry.lhs].inputs) {
+                        mark(input);
+                    }
+                } else if (entry.op == OpCode::TENSOR) {
+                    for (const uint32_t input : tensorOps[entry.lhs].inputs) {
+                        mark(input);
+                    }
+                } else {
+                    mark(entry.lhs);
+                    if (entry.rhs != NONE) {
+                        mark(entry.rhs);
+                    }
                 }
             }
         }
 
         /**
-         * @brief Clears the global computation tape.
+         * @brief Back-propagates from `root` like backward(uint32_t), running independent
+         * records on several cores.
+         *
+         * The records reached from the root are grouped into levels: a record's level is one
+         * more than the highest level of the records that consume its output, so once every
+         * lower level has run, its output gradient is final. The records of a level are
+         * independent of each other and run in parallel on TBB; several of them may still add
+         * into the same operand (a shared input, or a weight used by several samples), so those
+         * gradients are accumulated atomically. Levels smaller than `grain` run serially with
+         * plain accumulation. Tapes with checkpoints, or a capture in progress, fall back to
+         * the serial pass.
+         *
+         * @param root The node whose gradient has been seeded.
+         * @param grain Minimum number of records in a level worth running in parallel.
+         */
+        void backwardParallel(uint32_t root, size_t grain = 64) {
+            if (!checkpoints.empty() || !tensorOps.empty() || captured || (root & PERSISTENT)) {
+                backward(root);
+                return;
+            }
+            stats = {};
+
+            // Level of every reached record, found in one reverse walk: consumers come
+            // later on the tape than the records producing their operands.
+            levels.assign(arena.size(), 0);
+            schedule.clear();
+            uint32_t depth = 0;
+            mark(root);
+            for (size_t pos = tape.size(); pos-- > 0;) {
+                const Entry& entry = tape[pos];
+                if (!reached(entry)) {
+                    continue;
+                }
+                uint32_t level = levels[entry.out];
+                if (entry.op == OpCode::RELU_MASK) {
+                    const uint32_t* outputs = operands.data() + entry.lhs + entry.rhs;
+                    for (uint32_t idx = 1; idx < entry.rhs; ++idx) {
+                        level = std::max(level, levels[outputs[idx]]);
+                    }
+                }
+                schedule.emplace_back(level, static_cast<uint32_t>(pos));
+                depth = std::max(depth, level + 1);
+                if (isNary(entry)) {
+                    const uint32_t* args = operands.data() + entry.lhs;
+                    for (uint32_t idx = 0; idx < operandCount(entry); ++idx) {
+                        raise(args[idx], level + 1);
+                    }
+                } else {
+                    raise(entry.lhs, level + 1);
+                    if (entry.rhs != NONE) {
+                        raise(entry.rhs, level + 1);
+                    }
+                }
+            }
+
+            // Counting sort of the records by level
+            std::vector<size_t> begin(depth + 1, 0);
+            for (const auto& item : schedule) {
+                ++begin[item.first + 1];
+            }
+            for (uint32_t level = 0; level < depth; ++level) {
+                begin[level + 1] += begin[level];
+            }
+            order.resize(schedule.size());
+            std::vector<size_t> cursor(begin.begin(), begin.end() - 1);
+            for (const auto& item : schedule) {
+                order[cursor[item.first]++] = item.second;
+            }
+
+            for (uint32_t level = 0; level < depth; ++level) {
+                const size_t first = begin[level];
+                const size_t last = begin[level + 1];
+                if (last - first < grain) {
+                    for (size_t idx = first; idx < last; ++idx) {
+                        count(tape[order[idx]], operands, stats);
+                    }
+                    continue;
+                }
+                tbb::combinable<BackwardStats> partial;
+                tbb::parallel_for(tbb::blocked_range<size_t>(first, last), [this, &partial](const tbb::blocked_range<size_t>& range) {
+                    BackwardStats& local = partial.local();
+                    for (size_t idx = range.begin(); idx != range.end(); ++idx) {
+                        count<true>(tape[order[idx]], operands, local);
+                    }
+                });
+                partial.combine_each([this](const BackwardStats& local) {
+                    stats.executed += local.executed;
+                    stats.skipped += local.skipped;
+                    stats.skippedOperands += local.skippedOperands;
+                });
+            }
+        }
+
+        /**
+         * @brief Returns the current sizes of the tape's buffers.
+         */
+        __MICROGRADPP_NO_DISCARD__ TapePosition position() const {
+            return {tape.size(), operands.size(), checkpoints.size(), tensorOps.size(), arena.size()};
+        }
+
+        /**
+         * @brief Discards the records, operands, checkpoints and intermediate nodes created
+         * since `start`; earlier ones are kept. Handles to the discarded nodes must not be used.
+         * @param start A value previously returned by position().
+         */
+        void rewind(const TapePosition& start) {
+            tape.resize(start.records);
+            operands.resize(start.operands);
+            checkpoints.resize(start.checkpoints);
+            tensorOps.resize(start.tensorOps);
+            arena.rewind(start.nodes);
+        }
+
+        /**
+         * @brief Clears the calling thread's computation tape, releases every intermediate
+         * node and reclaims the long-lived nodes that were given back since the last clear.
          */
         static void clear() noexcept {
-            global_tape.tape.clear();
+            BasicAutograd& tape = current();
+            tape.tape.clear();
+            tape.operands.clear();
+            tape.checkpoints.clear();
+            tape.tensorOps.clear();
+            tape.arena.clear();
+            pool.release(tape.retired);
+            tape.retired.clear();
+#ifdef MICROGRADPP_DEBUG_METADATA
+            for (auto it = tape.metadata.begin(); it != tape.metadata.end();) {
+                it = (it->first & PERSISTENT) ? std::next(it) : tape.metadata.erase(it);
+            }
+#endif
+        }
+
+        /**
+         * @brief Returns whether operations are recorded on the tape on the calling thread.
+         * Always false for forward-mode node types (see Dual).
+         */
+        static bool isGradEnabled() noexcept {
+            return !NodeTraits<T>::forwardMode && GradMode::enabled;
+        }
+
+        /**
+         * @brief Enables or disables tape recording on the calling thread.
+         * @param enabled False to compute values only (inference mode).
+         */
+        static void setGradEnabled(bool enabled) noexcept {
+            GradMode::enabled = enabled;
+        }
+
+        /**
+         * @brief Returns the tape that operations on the calling thread are recorded on.
+         *
+         * This is the thread's default tape, created on first use, unless a TapeScope
+         * selected another one.
+         */
+        static BasicAutograd& current() {
+            BasicAutograd* tape = active();
+            return tape ? *tape : threadDefault();
+        }
+
+        /**
+         * @brief Makes `tape` the calling thread's current tape.
+         * @param tape The tape to record on, or nullptr for the thread's default tape.
+         * @return The previously selected tape (nullptr for the default tape).
+         */
+        static BasicAutograd* setCurrent(BasicAutograd* tape) noexcept {
+            BasicAutograd* previous = active();
+            active() = tape;
+            return previous;
+        }
+
+        static NodePool<T> pool; // Long-lived nodes (parameters, input data), shared by all threads
+
+    private:
+        /**
+         * @brief Returns the current tape of the thread, nullptr before first use.
+         *
+         * A function-local thread_local rather than a static member: it stays usable when the
+         * class is declared `extern template` and instantiated in another translation unit.
+         */
+        static BasicAutograd*& active() noexcept {
+            static thread_local BasicAutograd* tape = nullptr;
+            return tape;
+        }
+
+        /**
+         * @brief Creates the calling thread's default tape on first use and selects it.
+         */
+        static BasicAutograd& threadDefault() {
+            thread_local BasicAutograd tape;
+            active() = &tape;
+            return tape;
+        }
+
+        /**
+         * @brief Marks a node as reached by the pruned backward pass.
+         * Leaves are never the output of a record and are not marked.
+         */
+        void mark(uint32_t index) {
+            T& value = node(index);
+            if (value.op != OpCode::LEAF) {
+                value.flags |= T::REACHABLE;
+            }
+        }
+
+        /**
+         * @brief Marks a node as reached and lifts its level to at least `level`.
+         * Only intermediate nodes have a level; leaves are never the output of a record.
+         */
+        void raise(uint32_t index, uint32_t level) {
+            mark(index);
+            if (!(index & PERSISTENT)) {
+                levels[index] = std::max(levels[index], level);
+            }
+        }
+
+        /**
+         * @brief Adds `value` to a gradient, atomically when several threads may add to it.
+         */
+        template<bool Atomic, class Grad>
+        static void accumulate(Grad& grad, Compute value) {
+            if constexpr (Atomic) {
+#if defined(__cpp_lib_atomic_ref)
+                if constexpr (std::is_floating_point_v<Grad>) {
+                    std::atomic_ref<Grad>(grad).fetch_add(value, std::memory_order_relaxed);
+                    return;
+                }
+#endif
+                Grad expected;
+                __atomic_load(&grad, &expected, __ATOMIC_RELAXED);
+                Grad desired = static_cast<Compute>(expected) + value;
+                while (!__atomic_compare_exchange(&grad, &expected, &desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                    desired = static_cast<Compute>(expected) + value;
+                }
+            } else {
+                grad += value;
+            }
+        }
+
+        /**
+         * @brief Returns whether the pruned backward pass reached the output(s) of a record,
+         * clearing the marks it consumes.
+         */
+        bool reached(const Entry& entry) {
+            auto unmark = [this](uint32_t index) {
+                T& out = node(index);
+                const bool marked = out.flags & T::REACHABLE;
+                out.flags &= static_cast<uint8_t>(~T::REACHABLE);
+                return marked;
+            };
+            bool marked = false;
+            if (entry.op == OpCode::CHECKPOINT) {
+                for (const uint32_t output : checkpoints[entry.lhs].outputs) {
+                    marked |= unmark(output);
+                }
+            } else if (entry.op == OpCode::TENSOR) {
+                const auto& outputs = tensorOps[entry.lhs].outputs;
+                marked = outputs.empty();
+                for (const uint32_t output : outputs) {
+                    marked |= unmark(output);
+                }
+            } else if (entry.op == OpCode::RELU_MASK) {
+                const uint32_t* outputs = operands.data() + entry.lhs + entry.rhs;
+                for (uint32_t idx = 0; idx < entry.rhs; ++idx) {
+                    marked |= unmark(outputs[idx]);
+                }
+            } else {
+                marked = unmark(entry.out);
+            }
+            return marked;
+        }
+
+        /**
+         * @brief Rebuilds a checkpointed segment, back-propagates through it and discards it.
+         * @param id Index of the segment in `checkpoints`.
+         */
+        void recompute(uint32_t id) {
+            const TapePosition start = position();
+
+            const std::vector<uint32_t> rebuilt = checkpoints[id].recompute(checkpoints[id].inputs);
+            const auto& kept = checkpoints[id].outputs;
+            for (size_t idx = 0; idx < rebuilt.size(); ++idx) {
+                node(rebuilt[idx]).grad = node(kept[idx]).grad;
+            }
+            for (size_t pos = tape.size(); pos-- > start.records;) {
+                count(Entry(tape[pos]), operands, stats);
+            }
+
+            rewind(start);
+        }
+
+        /**
+         * @brief Applies the backward rule of one record unless it contributes nothing,
+         * and counts it in `counts`.
+         * @return true if the rule ran, false if the record was skipped.
+         */
+        template<bool Atomic = false>
+        bool count(const Entry& entry, const std::vector<uint32_t>& args, BackwardStats& counts) {
+            if (propagate<Atomic>(entry, args)) {
+                ++counts.executed;
+                return true;
+            }
+            ++counts.skipped;
+            if (isNary(entry)) {
+                counts.skippedOperands += operandCount(entry);
+            } else if (entry.op == OpCode::CHECKPOINT) {
+                counts.skippedOperands += checkpoints[entry.lhs].inputs.size();
+            } else if (entry.op == OpCode::TENSOR) {
+                counts.skippedOperands += tensorOps[entry.lhs].inputs.size();
+            } else {
+                counts.skippedOperands += entry.rhs == NONE ? 1 : 2;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Applies the backward rule of one record.
+         *
+         * Records whose contributions are all zero return early: a zero output gradient, a
+         * ReLU with a zero output, or a checkpointed segment none of whose outputs has a
+         * gradient (which is then not recomputed at all).
+         *
+         * @tparam Atomic Whether other records may add into the same operands concurrently.
+         * @param entry The record.
+         * @param args The operand buffer the n-ary records refer to.
+         * @return false if the record was skipped.
+         */
+        template<bool Atomic = false>
+        bool propagate(const Entry& entry, const std::vector<uint32_t>& args) {
+            if (entry.op == OpCode::CHECKPOINT) {
+                const auto& outputs = checkpoints[entry.lhs].outputs;
+                if (std::none_of(outputs.begin(), outputs.end(), [this](uint32_t index) { return node(index).grad != 0; })) {
+                    return false;
+                }
+                recompute(entry.lhs);
+                return true;
+            }
+            if (entry.op == OpCode::TENSOR) {
+                const TensorOp& op = tensorOps[entry.lhs];
+                if (!op.outputs.empty() && std::none_of(op.outputs.begin(), op.outputs.end(),
+                                                        [this](uint32_t index) { return node(index).grad != 0; })) {
+                    return false;
+                }
+                op.backward();
+                return true;
+            }
+            if (entry.op == OpCode::RELU_MASK) {
+                const uint32_t* inputs = args.data() + entry.lhs;
+                const uint32_t* outputs = inputs + entry.rhs;
+                const uint32_t* mask = outputs + entry.rhs;
+                bool contributed = false;
+                for (uint32_t idx = 0; idx < entry.rhs; ++idx) {
+                    if (!((mask[idx / 32] >> (idx % 32)) & 1u)) {
+                        continue;
+                    }
+                    const Compute grad = node(outputs[idx]).grad;
+                    if (grad != 0) {
+                        accumulate<Atomic>(node(inputs[idx]).grad, grad);
+                        contributed = true;
+                    }
+                }
+                return contributed;
+            }
+            T& out = node(entry.out);
+            const Compute outGrad = out.grad;
+            if (outGrad == 0 || (entry.op == OpCode::RELU && !(out.data > 0))) {
+                return false;
+            }
+            if (entry.op == OpCode::DOT) {
+                const uint32_t* weights = args.data() + entry.lhs;
+                const uint32_t* inputs = weights + entry.rhs;
+                for (uint32_t idx = 0; idx < entry.rhs; ++idx) {
+                    T& weight = node(weights[idx]);
+                    T& input = node(inputs[idx]);
+                    accumulate<Atomic>(weight.grad, input.data * outGrad);
+                    accumulate<Atomic>(input.grad, weight.data * outGrad);
+                }
+                accumulate<Atomic>(node(inputs[entry.rhs]).grad, outGrad);
+                return true;
+            }
+            if (entry.op == OpCode::SUM) {
+                const uint32_t* terms = args.data() + entry.lhs;
+                for (uint32_t idx = 0; idx < entry.rhs; ++idx) {
+                    accumulate<Atomic>(node(terms[idx]).grad, outGrad);
+                }
+                return true;
+            }
+            if (entry.op == OpCode::FUSED) {
+                const FusedKernel& kernel = FusedKernel::get(entry.rhs);
+                const uint32_t* nodes = args.data() + entry.lhs;
+                float values[FusedKernel::MAX_OPERANDS];
+                float constants[FusedKernel::MAX_OPERANDS];
+                float grads[FusedKernel::MAX_OPERANDS];
+                gather(kernel, nodes, values, constants);
+                kernel.backward(values, constants, static_cast<float>(outGrad), grads);
+                for (uint32_t idx = 0; idx < kernel.operands; ++idx) {
+                    accumulate<Atomic>(node(nodes[idx]).grad, grads[idx]);
+                }
+                return true;
+            }
+            T& lhs = node(entry.lhs);
+            switch (entry.op) {
+                case OpCode::ADD:
+                    accumulate<Atomic>(lhs.grad, outGrad);
+                    accumulate<Atomic>(node(entry.rhs).grad, outGrad);
+                    break;
+                case OpCode::SUBTRACT:
+                    accumulate<Atomic>(lhs.grad, outGrad);
+                    accumulate<Atomic>(node(entry.rhs).grad, -outGrad);
+                    break;
+                case OpCode::MULTIPLY: {
+                    T& rhs = node(entry.rhs);
+                    accumulate<Atomic>(lhs.grad, rhs.data * outGrad);
+                    accumulate<Atomic>(rhs.grad, lhs.data * outGrad);
+                    break;
+                }
+                case OpCode::ADD_CONST:
+                    accumulate<Atomic>(lhs.grad, outGrad);
+                    break;
+                case OpCode::MUL_CONST:
+                    accumulate<Atomic>(lhs.grad, entry.aux * outGrad);
+                    break;
+                case OpCode::POW:
+                    accumulate<Atomic>(lhs.grad, entry.aux * std::pow(static_cast<Compute>(lhs.data), entry.aux - 1) * outGrad);
+                    break;
+                case OpCode::TANH:
+                    accumulate<Atomic>(lhs.grad, (1 - entry.aux * entry.aux) * outGrad);
+                    break;
+                case OpCode::RELU:
+                    accumulate<Atomic>(lhs.grad, static_cast<Compute>(out.data > 0) * outGrad);
+                    break;
+                case OpCode::SIGMOID:
+                    accumulate<Atomic>(lhs.grad, entry.aux * (1 - entry.aux) * outGrad);
+                    break;
+                case OpCode::DOT:
+                case OpCode::SUM:
+                case OpCode::FUSED:
+                case OpCode::RELU_MASK:
+                case OpCode::CHECKPOINT:
+                case OpCode::TENSOR:
+                case OpCode::LEAF:
+                    break;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Reads the operand values and constants of a FUSED record.
+         */
+        void gather(const FusedKernel& kernel, const uint32_t* args, float* values, float* constants) {
+            for (uint32_t idx = 0; idx < kernel.operands; ++idx) {
+                values[idx] = static_cast<float>(node(args[idx]).data);
+            }
+            std::memcpy(constants, args + kernel.operands, kernel.constants * sizeof(float));
+        }
+    };
+
+    template<class T>
+    NodePool<T> BasicAutograd<T>::pool;
+
+    using Autograd = BasicAutograd<Value>;
+
+    /**
+     * @brief RAII guard that switches the calling thread to inference mode.
+     *
+     * While a guard is alive, operations compute values only: no tape entries are
+     * recorded and layers free their intermediate nodes as they go. The previous
+     * mode is restored when the guard is destroyed, so guards can be nested.
+     */
+    class NoGradGuard {
+    private:
+        bool _previous; ///< Mode to restore on destruction
+    public:
+        NoGradGuard() : _previous(GradMode::enabled) {
+            GradMode::enabled = false;
+        }
+
+        ~NoGradGuard() {
+            GradMode::enabled = _previous;
+        }
+
+        NoGradGuard(const NoGradGuard&) = delete;
+        NoGradGuard& operator=(const NoGradGuard&) = delete;
+    };
+
+    /**
+     * @brief RAII guard that records the calling thread's operations on an explicit tape.
+     *
+     * Use it to keep separate graphs apart on one thread, or to hand a worker thread a
+     * tape owned by the caller. The previously selected tape is restored when the guard
+     * is destroyed. Nodes created under the guard belong to `tape` and must not be used
+     * once the guard is gone.
+     *
+     * @tparam T The node type of the tape, deduced from the constructor argument.
+     */
+    template<class T = Value>
+    class TapeScope {
+    private:
+        BasicAutograd<T>* _previous; ///< Tape to restore on destruction
+    public:
+        explicit TapeScope(BasicAutograd<T>& tape) : _previous(BasicAutograd<T>::setCurrent(&tape)) {}
+
+        ~TapeScope() {
+            BasicAutograd<T>::setCurrent(_previous);
         }
 
-        static Autograd global_tape; // Global instance of Autograd for tracking operations
+        TapeScope(const TapeScope&) = delete;
+        TapeScope& operator=(const TapeScope&) = delete;
     };
 }
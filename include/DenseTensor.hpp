@@ -0,0 +1,1052 @@
+/**
+ *  @file DenseTensor.hpp
+ *  @brief Defines DenseTensor, a tensor of floats stored contiguously with its gradients.
+ *
+ *  This file is part of the microgradpp project, a lightweight C++ library for neural
+ *  network training and inference.
+ *
+ *  @section License
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  @section Author
+ *  Gautam Sharma
+ *  Email: gautamsharma2813@gmail.com
+ *  Date: October 16, 2026
+ *
+ *  @details
+ *  `Tensor1D` and `Tensor2D` hold one graph node per element. A DenseTensor instead owns
+ *  two float buffers, the values and their gradients, and describes its elements with a
+ *  shape and strides. Operations work on whole tensors and record a single tape entry
+ *  (OpCode::TENSOR) whose backward rule loops over the buffers; `matmul` runs on the
+ *  blocked SIMD kernels of Gemm.hpp:
+ *  @code
+ *  DenseTensor x({64, 100}, values);
+ *  DenseTensor w({100, 10}, weights);
+ *  auto loss = DenseTensor::sum(DenseTensor::matmul(x, w));
+ *  loss.backward();                       // w.grad() now holds d loss / d w
+ *  @endcode
+ *  Tensors are handles: copies, `reshape()` and `transpose()` share the buffers, so a view
+ *  needs no tape entry and its gradients land in the tensor it views. `from()` and
+ *  `toTensor1D()`/`toTensor2D()` convert to and from node tensors; gradients flow across
+ *  both conversions.
+ *
+ *  The elementwise ops (`add`, `subtract`, `multiply`, `divide`, `pow`, `tanh`, `relu`,
+ *  `sigmoid`) broadcast like NumPy, so a bias add over a batch is one op and one record.
+ *
+ *  Data already in memory is loaded with `copy()`, one allocation and one memcpy, or
+ *  used in place with `adopt()` and a DenseBufferGuard.
+ */
+
+#pragma once
+
+// Standard libraries
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// microgradpp headers
+#include "Autograd.hpp"
+#include "Gemm.hpp"
+#include "Value.hpp"
+#include "Tensor.hpp"
+#include "TypeDefs.hpp"
+
+namespace microgradpp {
+
+    /**
+     * @brief The buffers of a DenseTensor, shared by the tensor and its views.
+     *
+     * The values are either owned or live in a caller's buffer adopted by
+     * DenseTensor::adopt(); the gradients are always owned.
+     */
+    struct DenseStorage {
+        std::vector<float> owned;  ///< Owned values, empty while a caller's buffer is adopted
+        float* values;             ///< Element values: `owned.data()` or the adopted buffer
+        std::vector<float> grads;  ///< Element gradients, one per value
+        bool adopted = false;      ///< True while `values` points into a caller's buffer
+
+        explicit DenseStorage(std::vector<float> data)
+                : owned(std::move(data)), values(owned.data()), grads(owned.size(), 0.0f) {}
+
+        DenseStorage(float* data, size_t size) : values(data), grads(size, 0.0f), adopted(true) {}
+
+        DenseStorage(const DenseStorage&) = delete;
+        DenseStorage& operator=(const DenseStorage&) = delete;
+
+        /**
+         * @brief Copies adopted values into owned memory, after which the caller's buffer
+         * is no longer read or written.
+         */
+        void detach() {
+            if (adopted) {
+                owned.assign(values, values + grads.size());
+                values = owned.data();
+                adopted = false;
+            }
+        }
+    };
+
+    /**
+     * @brief Guards the tensors made by DenseTensor::adopt() against outliving the buffer.
+     *
+     * Declare the guard after the buffer so it is destroyed first. On destruction (or
+     * `release()`), every tensor still using the buffer copies its values into memory of
+     * its own; until then the tensors read and write the buffer directly.
+     * @code
+     * std::vector<float> pixels = load();
+     * DenseBufferGuard guard;
+     * auto image = DenseTensor::adopt(pixels.data(), {50, 50}, guard);  // no copy
+     * @endcode
+     */
+    class DenseBufferGuard {
+    private:
+        friend class DenseTensor;
+        std::vector<std::weak_ptr<DenseStorage>> _storages; ///< Storages adopting the buffer
+
+    public:
+        DenseBufferGuard() = default;
+        DenseBufferGuard(const DenseBufferGuard&) = delete;
+        DenseBufferGuard& operator=(const DenseBufferGuard&) = delete;
+
+        ~DenseBufferGuard() {
+            release();
+        }
+
+        /**
+         * @brief Makes the guarded tensors stop using the buffer.
+         */
+        void release() {
+            for (const auto& storage : _storages) {
+                if (const auto alive = storage.lock()) {
+                    alive->detach();
+                }
+            }
+            _storages.clear();
+        }
+    };
+
+    /**
+     * @class DenseTensor
+     * @brief An n-dimensional tensor of floats with contiguous value and gradient buffers.
+     *
+     * Element `(i0, i1, ...)` is stored at `offset + i0 * strides[0] + i1 * strides[1] + ...`
+     * of both buffers. Newly created tensors are contiguous (row-major); views made by
+     * `transpose()` may not be.
+     */
+    class DenseTensor {
+    public:
+        using Shape = std::vector<size_t>; ///< Extent (or stride) of every dimension
+
+    private:
+        std::shared_ptr<DenseStorage> _storage; ///< Buffers, shared with the views
+        Shape _shape;                           ///< Extent of every dimension
+        Shape _strides;                         ///< Distance between neighbours of every dimension
+        size_t _offset = 0;                     ///< Position of the first element in the buffers
+
+    public:
+        DenseTensor() = default;
+
+        /**
+         * @brief Creates a tensor with every element set to `fill`.
+         * @param shape The extent of every dimension.
+         * @param fill The initial value.
+         */
+        explicit DenseTensor(Shape shape, float fill = 0.0f)
+                : _storage(std::make_shared<DenseStorage>(std::vector<float>(elements(shape), fill))),
+                  _shape(std::move(shape)), _strides(contiguousStrides(_shape)) {}
+
+        /**
+         * @brief Creates a tensor from values in row-major order.
+         * @param shape The extent of every dimension.
+         * @param values The values, as many as the shape has elements.
+         * @throws std::invalid_argument If the number of values does not match the shape.
+         */
+        DenseTensor(Shape shape, std::vector<float> values) {
+            if (values.size() != elements(shape)) {
+                throw std::invalid_argument("Error in microgradpp::DenseTensor -> number of values does not match the shape");
+            }
+            _storage = std::make_shared<DenseStorage>(std::move(values));
+            _shape = std::move(shape);
+            _strides = contiguousStrides(_shape);
+        }
+
+        /**
+         * @brief Creates a tensor from a copy of a row-major buffer, made with one allocation.
+         * @param data The values, as many as the shape has elements. Only read.
+         * @param shape The extent of every dimension.
+         * @return The tensor.
+         */
+        static DenseTensor copy(const float* data, Shape shape) {
+            const size_t count = elements(shape);
+            return {std::move(shape), std::vector<float>(data, data + count)};
+        }
+
+        /**
+         * @brief Creates a tensor over a caller's row-major buffer without copying it.
+         *
+         * The tensor and its views read and write `data` directly until `guard` is released,
+         * then use a copy of their own. Only the gradient buffer is allocated.
+         *
+         * @param data The values, as many as the shape has elements.
+         * @param shape The extent of every dimension.
+         * @param guard Destroyed or released before the buffer goes away.
+         * @return The tensor.
+         */
+        static DenseTensor adopt(float* data, Shape shape, DenseBufferGuard& guard) {
+            DenseTensor out;
+            out._storage = std::make_shared<DenseStorage>(data, elements(shape));
+            out._shape = std::move(shape);
+            out._strides = contiguousStrides(out._shape);
+            guard._storages.push_back(out._storage);
+            return out;
+        }
+
+        /**
+         * @brief Returns the number of elements of a shape.
+         */
+        static size_t elements(const Shape& shape) {
+            size_t count = 1;
+            for (const size_t extent : shape) {
+                count *= extent;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Returns the row-major strides of a shape.
+         */
+        static Shape contiguousStrides(const Shape& shape) {
+            Shape strides(shape.size(), 1);
+            for (size_t axis = shape.size(); axis-- > 1;) {
+                strides[axis - 1] = strides[axis] * shape[axis];
+            }
+            return strides;
+        }
+
+        __MICROGRADPP_NO_DISCARD__ const Shape& shape() const { return _shape; }
+        __MICROGRADPP_NO_DISCARD__ const Shape& strides() const { return _strides; }
+        __MICROGRADPP_NO_DISCARD__ size_t dim() const { return _shape.size(); }
+        __MICROGRADPP_NO_DISCARD__ size_t size() const { return elements(_shape); }
+
+        /**
+         * @brief Returns true if the elements are laid out row-major without gaps.
+         */
+        __MICROGRADPP_NO_DISCARD__ bool isContiguous() const {
+            return _strides == contiguousStrides(_shape);
+        }
+
+        /**
+         * @brief Returns the address of the first element's value; with `strides()` it
+         * addresses every element.
+         */
+        float* data() { return _storage->values + _offset; }
+        const float* data() const { return _storage->values + _offset; }
+
+        /**
+         * @brief Returns the address of the first element's gradient, laid out like data().
+         */
+        float* grad() { return _storage->grads.data() + _offset; }
+        const float* grad() const { return _storage->grads.data() + _offset; }
+
+        /**
+         * @brief Accesses the value of one element.
+         * @param index One index per dimension.
+         * @throws std::out_of_range If the index is outside the shape.
+         */
+        float& at(const Shape& index) { return data()[position(index)]; }
+        __MICROGRADPP_NO_DISCARD__ float at(const Shape& index) const { return data()[position(index)]; }
+
+        /**
+         * @brief Accesses the gradient of one element.
+         * @param index One index per dimension.
+         * @throws std::out_of_range If the index is outside the shape.
+         */
+        float& gradAt(const Shape& index) { return grad()[position(index)]; }
+        __MICROGRADPP_NO_DISCARD__ float gradAt(const Shape& index) const { return grad()[position(index)]; }
+
+        /**
+         * @brief Copies the values out in row-major order.
+         */
+        __MICROGRADPP_NO_DISCARD__ std::vector<float> values() const {
+            return gather(data());
+        }
+
+        /**
+         * @brief Copies the gradients out in row-major order.
+         */
+        __MICROGRADPP_NO_DISCARD__ std::vector<float> grads() const {
+            return gather(grad());
+        }
+
+        /**
+         * @brief Sets the gradients of the tensor's elements to zero.
+         */
+        void zeroGrad() {
+            float* grads = grad();
+            forEachOffset([grads](size_t offset) { grads[offset] = 0.0f; });
+        }
+
+        /**
+         * @brief Returns a view with another shape of the same elements.
+         * @param shape The new shape, with as many elements as the tensor.
+         * @throws std::invalid_argument If the tensor is not contiguous or the sizes differ.
+         */
+        __MICROGRADPP_NO_DISCARD__ DenseTensor reshape(Shape shape) const {
+            if (!isContiguous() || elements(shape) != size()) {
+                throw std::invalid_argument("Error in microgradpp::DenseTensor::reshape -> needs a contiguous tensor of the same size");
+            }
+            DenseTensor view = *this;
+            view._strides = contiguousStrides(shape);
+            view._shape = std::move(shape);
+            return view;
+        }
+
+        /**
+         * @brief Returns the transposed view of a 2D tensor.
+         * @throws std::invalid_argument If the tensor is not 2D.
+         */
+        __MICROGRADPP_NO_DISCARD__ DenseTensor transpose() const {
+            if (dim() != 2) {
+                throw std::invalid_argument("Error in microgradpp::DenseTensor::transpose -> needs a 2D tensor");
+            }
+            DenseTensor view = *this;
+            std::swap(view._shape[0], view._shape[1]);
+            std::swap(view._strides[0], view._strides[1]);
+            return view;
+        }
+
+        /**
+         * @brief Back-propagates from this single-element tensor through the current tape.
+         *
+         * Seeds the tensor's gradient with 1 and runs every recorded backward rule in
+         * reverse order.
+         * @throws std::logic_error If the tensor has more than one element.
+         */
+        void backward() {
+            if (size() != 1) {
+                throw std::logic_error("Error in microgradpp::DenseTensor::backward -> needs a single-element tensor");
+            }
+            grad()[0] = 1.0f;
+            Autograd::current().backward();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Operations
+        ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        /**
+         * @brief Elementwise `lhs + rhs` with NumPy broadcasting.
+         *
+         * Shapes are aligned at their last dimension; extents must be equal or 1, and an
+         * extent of 1 (or a missing dimension) is repeated to match the other tensor. The
+         * gradient of a broadcast operand is summed over the dimensions it was repeated
+         * along, so e.g. `add(x, bias)` with x {batch, n} and bias {n} is one op.
+         * @throws std::invalid_argument If the shapes cannot be broadcast together.
+         */
+        static DenseTensor add(const DenseTensor& lhs, const DenseTensor& rhs) {
+            DenseTensor out = elementwise(lhs, rhs, [](float x, float y) { return x + y; });
+            record([lhs = lhs, rhs = rhs, out]() mutable {
+                reduceInto(lhs, out._shape, out.grad());
+                reduceInto(rhs, out._shape, out.grad());
+            });
+            return out;
+        }
+
+        /**
+         * @brief Elementwise `lhs - rhs` with broadcasting (see add()).
+         * @throws std::invalid_argument If the shapes cannot be broadcast together.
+         */
+        static DenseTensor subtract(const DenseTensor& lhs, const DenseTensor& rhs) {
+            DenseTensor out = elementwise(lhs, rhs, [](float x, float y) { return x - y; });
+            record([lhs = lhs, rhs = rhs, out]() mutable {
+                const size_t count = out.size();
+                const float* g = out.grad();
+                reduceInto(lhs, out._shape, g);
+                std::vector<float> negated(count);
+                for (size_t idx = 0; idx < count; ++idx) {
+                    negated[idx] = -g[idx];
+                }
+                reduceInto(rhs, out._shape, negated.data());
+            });
+            return out;
+        }
+
+        /**
+         * @brief Elementwise `lhs * rhs` with broadcasting (see add()).
+         * @throws std::invalid_argument If the shapes cannot be broadcast together.
+         */
+        static DenseTensor multiply(const DenseTensor& lhs, const DenseTensor& rhs) {
+            DenseTensor out = elementwise(lhs, rhs, [](float x, float y) { return x * y; });
+            record([lhs = lhs, rhs = rhs, out]() mutable {
+                const auto times = [](float g, float y) { return g * y; };
+                reduceInto(lhs, out._shape, against(out.grad(), out._shape, rhs, times).data());
+                reduceInto(rhs, out._shape, against(out.grad(), out._shape, lhs, times).data());
+            });
+            return out;
+        }
+
+        /**
+         * @brief Elementwise `lhs / rhs` with broadcasting (see add()).
+         * @throws std::invalid_argument If the shapes cannot be broadcast together.
+         */
+        static DenseTensor divide(const DenseTensor& lhs, const DenseTensor& rhs) {
+            DenseTensor out = elementwise(lhs, rhs, [](float x, float y) { return x / y; });
+            record([lhs = lhs, rhs = rhs, out]() mutable {
+                // d lhs = g / rhs, d rhs = -g * lhs / rhs^2 = -g * out / rhs
+                reduceInto(lhs, out._shape, against(out.grad(), out._shape, rhs,
+                                                    [](float g, float y) { return g / y; }).data());
+                const size_t count = out.size();
+                const float* g = out.grad();
+                const float* o = out.data();
+                std::vector<float> product(count);
+                for (size_t idx = 0; idx < count; ++idx) {
+                    product[idx] = g[idx] * o[idx];
+                }
+                reduceInto(rhs, out._shape, against(product.data(), out._shape, rhs,
+                                                    [](float p, float y) { return -p / y; }).data());
+            });
+            return out;
+        }
+
+        /**
+         * @brief Elementwise `base ^ exponent` with broadcasting (see add()).
+         *
+         * The exponent's gradient contains log(base), so it is NaN where the base is not
+         * positive; use the float overload for constant exponents.
+         * @throws std::invalid_argument If the shapes cannot be broadcast together.
+         */
+        static DenseTensor pow(const DenseTensor& base, const DenseTensor& exponent) {
+            DenseTensor out = elementwise(base, exponent, [](float x, float y) { return std::pow(x, y); });
+            record([base = base, exponent = exponent, out]() mutable {
+                // d base = g * e * base^(e - 1), d exponent = g * out * log(base)
+                const size_t count = out.size();
+                const float* g = out.grad();
+                const float* o = out.data();
+                std::vector<float> contribution = elementwiseValues(base, exponent,
+                        [](float x, float y) { return y * std::pow(x, y - 1); });
+                for (size_t idx = 0; idx < count; ++idx) {
+                    contribution[idx] *= g[idx];
+                }
+                reduceInto(base, out._shape, contribution.data());
+                for (size_t idx = 0; idx < count; ++idx) {
+                    contribution[idx] = g[idx] * o[idx];
+                }
+                reduceInto(exponent, out._shape, against(contribution.data(), out._shape, base,
+                                                         [](float p, float x) { return p * std::log(x); }).data());
+            });
+            return out;
+        }
+
+        /**
+         * @brief Elementwise `base ^ exponent` for a constant exponent.
+         */
+        static DenseTensor pow(const DenseTensor& base, float exponent) {
+            DenseTensor out = unary(base, [exponent](float x) { return std::pow(x, exponent); });
+            record([base = base, out, exponent]() mutable {
+                std::vector<float> scratch;
+                const float* x = base.read(scratch);
+                const float* g = out.grad();
+                const size_t count = out.size();
+                std::vector<float> contribution(count);
+                for (size_t idx = 0; idx < count; ++idx) {
+                    contribution[idx] = g[idx] * exponent * std::pow(x[idx], exponent - 1);
+                }
+                base.accumulate(contribution.data());
+            });
+            return out;
+        }
+
+        /**
+         * @brief Elementwise hyperbolic tangent.
+         */
+        static DenseTensor tanh(const DenseTensor& in) {
+            DenseTensor out = unary(in, [](float x) { return std::tanh(x); });
+            record([in = in, out]() mutable {
+                in.accumulate(fromOutput(out, [](float g, float o) { return g * (1 - o * o); }).data());
+            });
+            return out;
+        }
+
+        /**
+         * @brief Elementwise `max(0, x)`.
+         */
+        static DenseTensor relu(const DenseTensor& in) {
+            DenseTensor out = unary(in, [](float x) { return x > 0 ? x : 0.0f; });
+            record([in = in, out]() mutable {
+                in.accumulate(fromOutput(out, [](float g, float o) { return o > 0 ? g : 0.0f; }).data());
+            });
+            return out;
+        }
+
+        /**
+         * @brief Elementwise logistic function `1 / (1 + exp(-x))`.
+         */
+        static DenseTensor sigmoid(const DenseTensor& in) {
+            DenseTensor out = unary(in, [](float x) { return 1 / (1 + std::exp(-x)); });
+            record([in = in, out]() mutable {
+                in.accumulate(fromOutput(out, [](float g, float o) { return g * o * (1 - o); }).data());
+            });
+            return out;
+        }
+
+        /**
+         * @brief Sum of all elements, as a tensor of shape {1}.
+         */
+        static DenseTensor sum(const DenseTensor& in) {
+            std::vector<float> scratch;
+            const float* x = in.read(scratch);
+            const size_t n = in.size();
+            float total = 0.0f;
+            for (size_t idx = 0; idx < n; ++idx) {
+                total += x[idx];
+            }
+            DenseTensor out({1}, total);
+            record([in = in, out]() mutable {
+                const std::vector<float> g(in.size(), out.grad()[0]);
+                in.accumulate(g.data());
+            });
+            return out;
+        }
+
+        /**
+         * @brief Matrix product of a {m, k} and a {k, n} tensor.
+         * @throws std::invalid_argument If the tensors are not 2D or the inner extents differ.
+         */
+        static DenseTensor matmul(const DenseTensor& lhs, const DenseTensor& rhs) {
+            if (lhs.dim() != 2 || rhs.dim() != 2 || lhs._shape[1] != rhs._shape[0]) {
+                throw std::invalid_argument("Error in microgradpp::DenseTensor::matmul -> needs {m, k} and {k, n} tensors");
+            }
+            const size_t m = lhs._shape[0], k = lhs._shape[1], n = rhs._shape[1];
+            DenseTensor out({m, n});
+            std::vector<float> scratchL, scratchR;
+            const Matrix a = lhs.matrix(scratchL), b = rhs.matrix(scratchR);
+            gemm::sgemm(a.transposed, b.transposed, m, n, k, a.data, a.ld, b.data, b.ld, out.data(), n);
+            record([lhs = lhs, rhs = rhs, out, m, n, k]() mutable {
+                // d lhs += d out * rhs^T (NT), d rhs += lhs^T * d out (TN)
+                std::vector<float> scratchL, scratchR, gradL, gradR;
+                const Matrix a = lhs.matrix(scratchL), b = rhs.matrix(scratchR);
+                float* targetL = lhs.gradTarget(gradL);
+                gemm::sgemm(false, !b.transposed, m, k, n, out.grad(), n, b.data, b.ld, targetL, k);
+                lhs.finishGrad(gradL);
+                float* targetR = rhs.gradTarget(gradR);
+                gemm::sgemm(!a.transposed, false, k, n, m, a.data, a.ld, out.grad(), n, targetR, n);
+                rhs.finishGrad(gradR);
+            });
+            return out;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Conversions
+        ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        /**
+         * @brief Copies a node tensor into a tensor of shape {n}. Gradients of the result
+         * flow back into the nodes.
+         */
+        static DenseTensor from(const Tensor1D& in) {
+            std::vector<float> values;
+            std::vector<uint32_t> nodes;
+            values.reserve(in.size());
+            nodes.reserve(in.size());
+            for (const auto& value : in) {
+                values.push_back(value->data);
+                nodes.push_back(value.index);
+            }
+            DenseTensor out({in.size()}, std::move(values));
+            readNodes(std::move(nodes), out);
+            return out;
+        }
+
+        /**
+         * @brief Copies a node tensor into a tensor of shape {rows, columns}. Gradients of
+         * the result flow back into the nodes.
+         * @throws std::invalid_argument If the rows differ in length.
+         */
+        static DenseTensor from(const Tensor2D& in) {
+            const size_t rows = in.size();
+            const size_t columns = rows ? in[0].size() : 0;
+            std::vector<float> values;
+            std::vector<uint32_t> nodes;
+            values.reserve(rows * columns);
+            nodes.reserve(rows * columns);
+            for (const auto& row : in) {
+                if (row.size() != columns) {
+                    throw std::invalid_argument("Error in microgradpp::DenseTensor::from -> rows differ in length");
+                }
+                for (const auto& value : row) {
+                    values.push_back(value->data);
+                    nodes.push_back(value.index);
+                }
+            }
+            DenseTensor out({rows, columns}, std::move(values));
+            readNodes(std::move(nodes), out);
+            return out;
+        }
+
+        /**
+         * @brief Copies a 1D tensor into new intermediate nodes. Gradients of the nodes flow
+         * back into this tensor.
+         * @throws std::logic_error If the tensor is not 1D.
+         */
+        __MICROGRADPP_NO_DISCARD__ Tensor1D toTensor1D() const {
+            if (dim() != 1) {
+                throw std::logic_error("Error in microgradpp::DenseTensor::toTensor1D -> needs a 1D tensor");
+            }
+            Tensor1D out;
+            writeNodes(out);
+            return out;
+        }
+
+        /**
+         * @brief Copies a 2D tensor into new intermediate nodes, one row per Tensor1D.
+         * Gradients of the nodes flow back into this tensor.
+         * @throws std::logic_error If the tensor is not 2D.
+         */
+        __MICROGRADPP_NO_DISCARD__ Tensor2D toTensor2D() const {
+            if (dim() != 2) {
+                throw std::logic_error("Error in microgradpp::DenseTensor::toTensor2D -> needs a 2D tensor");
+            }
+            Tensor1D flat;
+            writeNodes(flat);
+            Tensor2D out;
+            for (size_t row = 0; row < _shape[0]; ++row) {
+                Tensor1D values;
+                values.reserve(_shape[1]);
+                for (size_t column = 0; column < _shape[1]; ++column) {
+                    values.push_back(flat[row * _shape[1] + column]);
+                }
+                out.push_back(values);
+            }
+            return out;
+        }
+
+    private:
+        /**
+         * @brief Returns the buffer position of an element relative to data().
+         */
+        size_t position(const Shape& index) const {
+            if (index.size() != _shape.size()) {
+                throw std::out_of_range("Error in microgradpp::DenseTensor -> index has the wrong number of dimensions");
+            }
+            size_t offset = 0;
+            for (size_t axis = 0; axis < index.size(); ++axis) {
+                if (index[axis] >= _shape[axis]) {
+                    throw std::out_of_range("Error in microgradpp::DenseTensor -> index out of bounds");
+                }
+                offset += index[axis] * _strides[axis];
+            }
+            return offset;
+        }
+
+        /**
+         * @brief Calls `visit` with the buffer position (relative to data()) of every
+         * element, in row-major order.
+         */
+        template<class Visit>
+        void forEachOffset(Visit&& visit) const {
+            const size_t count = size();
+            if (isContiguous()) {
+                for (size_t idx = 0; idx < count; ++idx) {
+                    visit(idx);
+                }
+                return;
+            }
+            Shape index(_shape.size(), 0);
+            size_t offset = 0;
+            for (size_t idx = 0; idx < count; ++idx) {
+                visit(offset);
+                for (size_t axis = _shape.size(); axis-- > 0;) {
+                    offset += _strides[axis];
+                    if (++index[axis] < _shape[axis]) {
+                        break;
+                    }
+                    offset -= _strides[axis] * _shape[axis];
+                    index[axis] = 0;
+                }
+            }
+        }
+
+        /**
+         * @brief Copies the elements of a buffer laid out like this tensor in row-major order.
+         */
+        std::vector<float> gather(const float* buffer) const {
+            std::vector<float> out;
+            out.reserve(size());
+            forEachOffset([&out, buffer](size_t offset) { out.push_back(buffer[offset]); });
+            return out;
+        }
+
+        /**
+         * @brief Returns the values in row-major order: data() itself when the tensor is
+         * contiguous, otherwise a copy made in `scratch`.
+         */
+        const float* read(std::vector<float>& scratch) const {
+            if (isContiguous()) {
+                return data();
+            }
+            scratch = values();
+            return scratch.data();
+        }
+
+        /**
+         * @brief Adds gradients given in row-major order to the tensor's gradients.
+         */
+        void accumulate(const float* grads) {
+            float* target = grad();
+            if (isContiguous()) {
+                const size_t count = size();
+                for (size_t idx = 0; idx < count; ++idx) {
+                    target[idx] += grads[idx];
+                }
+                return;
+            }
+            size_t next = 0;
+            forEachOffset([target, grads, &next](size_t offset) { target[offset] += grads[next++]; });
+        }
+
+        /**
+         * @brief A 2D tensor as sgemm addresses it: rows `ld` apart, or transposed.
+         */
+        struct Matrix {
+            const float* data;
+            size_t ld;
+            bool transposed;
+        };
+
+        /**
+         * @brief Describes this 2D tensor to sgemm, copying it to `scratch` when neither
+         * dimension is unit-stride.
+         */
+        Matrix matrix(std::vector<float>& scratch) const {
+            if (_strides[1] == 1) {
+                return {data(), _strides[0], false};
+            }
+            if (_strides[0] == 1) {
+                return {data(), _strides[1], true};
+            }
+            scratch = values();
+            return {scratch.data(), _shape[1], false};
+        }
+
+        /**
+         * @brief Returns where a product may add this tensor's gradients in row-major order:
+         * grad() itself when contiguous, otherwise zeros in `scratch` to be passed to
+         * finishGrad().
+         */
+        float* gradTarget(std::vector<float>& scratch) {
+            if (isContiguous()) {
+                return grad();
+            }
+            scratch.assign(size(), 0.0f);
+            return scratch.data();
+        }
+
+        /**
+         * @brief Adds gradients collected by gradTarget() into a non-contiguous tensor.
+         */
+        void finishGrad(const std::vector<float>& scratch) {
+            if (!scratch.empty()) {
+                accumulate(scratch.data());
+            }
+        }
+
+        /**
+         * @brief How two row-major shapes broadcast together.
+         *
+         * Dimensions of the result are collapsed where both operands advance through them
+         * in step (or both are repeated), so an elementwise op on equal shapes is a single
+         * loop and a bias add is one loop per row. Along the innermost dimension each
+         * operand either advances by one or stays put.
+         */
+        struct Broadcast {
+            Shape shape;      ///< Shape of the result
+            Shape extents;    ///< Extents of the collapsed dimensions, innermost last
+            Shape lhsStrides; ///< Step of lhs along every collapsed dimension, 0 where repeated
+            Shape rhsStrides; ///< Step of rhs along every collapsed dimension, 0 where repeated
+
+            Broadcast(const Shape& lhs, const Shape& rhs) {
+                const size_t rank = std::max(lhs.size(), rhs.size());
+                Shape left(rank, 1), right(rank, 1);
+                std::copy(lhs.begin(), lhs.end(), left.end() - lhs.size());
+                std::copy(rhs.begin(), rhs.end(), right.end() - rhs.size());
+                Shape leftStrides = contiguousStrides(left), rightStrides = contiguousStrides(right);
+                shape.resize(rank);
+                for (size_t axis = 0; axis < rank; ++axis) {
+                    if (left[axis] != right[axis] && left[axis] != 1 && right[axis] != 1) {
+                        throw std::invalid_argument("Error in microgradpp::DenseTensor -> shapes cannot be broadcast together");
+                    }
+                    shape[axis] = left[axis] == 1 ? right[axis] : left[axis];
+                    if (left[axis] == 1) {
+                        leftStrides[axis] = 0;
+                    }
+                    if (right[axis] == 1) {
+                        rightStrides[axis] = 0;
+                    }
+                }
+                for (size_t axis = 0; axis < rank; ++axis) {
+                    if (shape[axis] == 1) {
+                        continue;
+                    }
+                    if (!extents.empty() && lhsStrides.back() == leftStrides[axis] * shape[axis]
+                        && rhsStrides.back() == rightStrides[axis] * shape[axis]) {
+                        extents.back() *= shape[axis];
+                        lhsStrides.back() = leftStrides[axis];
+                        rhsStrides.back() = rightStrides[axis];
+                        continue;
+                    }
+                    extents.push_back(shape[axis]);
+                    lhsStrides.push_back(leftStrides[axis]);
+                    rhsStrides.push_back(rightStrides[axis]);
+                }
+                if (extents.empty()) {
+                    extents = {1};
+                    lhsStrides = {0};
+                    rhsStrides = {0};
+                }
+            }
+
+            /**
+             * @brief Calls `row(out, lhs, rhs)` with the offsets of every innermost row, in
+             * row-major order. Rows are `extents.back()` elements long.
+             */
+            template<class Row>
+            void forEachRow(Row&& row) const {
+                const size_t count = elements(shape);
+                if (count == 0) {
+                    return;
+                }
+                const size_t dims = extents.size(), inner = extents.back();
+                Shape index(dims, 0);
+                size_t lhs = 0, rhs = 0;
+                for (size_t out = 0; out < count; out += inner) {
+                    row(out, lhs, rhs);
+                    for (size_t axis = dims - 1; axis-- > 0;) {
+                        lhs += lhsStrides[axis];
+                        rhs += rhsStrides[axis];
+                        if (++index[axis] < extents[axis]) {
+                            break;
+                        }
+                        lhs -= lhsStrides[axis] * extents[axis];
+                        rhs -= rhsStrides[axis] * extents[axis];
+                        index[axis] = 0;
+                    }
+                }
+            }
+        };
+
+        /**
+         * @brief o[i] = f(a[i], b[i]) over a broadcast. `a` and `b` are row-major buffers
+         * of the plan's operand shapes, `o` one of its result shape.
+         */
+        template<class F>
+        static void map(const Broadcast& plan, F f, const float* a, const float* b, float* o) {
+            const size_t n = plan.extents.back();
+            const bool aStep = plan.lhsStrides.back() != 0, bStep = plan.rhsStrides.back() != 0;
+            plan.forEachRow([&](size_t out, size_t lhs, size_t rhs) {
+                const float* x = a + lhs;
+                const float* y = b + rhs;
+                float* z = o + out;
+                // One branch per operand pattern, so every loop is unit-stride
+                if (aStep && bStep) {
+                    for (size_t idx = 0; idx < n; ++idx) {
+                        z[idx] = f(x[idx], y[idx]);
+                    }
+                } else if (aStep) {
+                    const float yValue = *y;
+                    for (size_t idx = 0; idx < n; ++idx) {
+                        z[idx] = f(x[idx], yValue);
+                    }
+                } else if (bStep) {
+                    const float xValue = *x;
+                    for (size_t idx = 0; idx < n; ++idx) {
+                        z[idx] = f(xValue, y[idx]);
+                    }
+                } else {
+                    const float value = f(*x, *y);
+                    for (size_t idx = 0; idx < n; ++idx) {
+                        z[idx] = value;
+                    }
+                }
+            });
+        }
+
+        /**
+         * @brief Returns f(lhs, rhs) broadcast, in row-major order.
+         */
+        template<class F>
+        static std::vector<float> elementwiseValues(const DenseTensor& lhs, const DenseTensor& rhs, F f) {
+            const Broadcast plan(lhs._shape, rhs._shape);
+            std::vector<float> scratchL, scratchR, out(elements(plan.shape));
+            map(plan, f, lhs.read(scratchL), rhs.read(scratchR), out.data());
+            return out;
+        }
+
+        /**
+         * @brief Returns the tensor f(lhs, rhs) broadcast; records nothing.
+         */
+        template<class F>
+        static DenseTensor elementwise(const DenseTensor& lhs, const DenseTensor& rhs, F f) {
+            const Broadcast plan(lhs._shape, rhs._shape);
+            std::vector<float> scratchL, scratchR;
+            DenseTensor out(plan.shape);
+            map(plan, f, lhs.read(scratchL), rhs.read(scratchR), out.data());
+            return out;
+        }
+
+        /**
+         * @brief Returns f(full[i], operand broadcast to `shape`) for a row-major buffer `full`
+         * of that shape.
+         */
+        template<class F>
+        static std::vector<float> against(const float* full, const Shape& shape, const DenseTensor& operand, F f) {
+            std::vector<float> scratch, out(elements(shape));
+            map(Broadcast(shape, operand._shape), f, full, operand.read(scratch), out.data());
+            return out;
+        }
+
+        /**
+         * @brief Returns the tensor f(in); records nothing.
+         */
+        template<class F>
+        static DenseTensor unary(const DenseTensor& in, F f) {
+            std::vector<float> scratch;
+            const float* x = in.read(scratch);
+            DenseTensor out(in._shape);
+            float* o = out.data();
+            const size_t count = out.size();
+            for (size_t idx = 0; idx < count; ++idx) {
+                o[idx] = f(x[idx]);
+            }
+            return out;
+        }
+
+        /**
+         * @brief Returns f(gradient, value) for every element of an op's output.
+         */
+        template<class F>
+        static std::vector<float> fromOutput(const DenseTensor& out, F f) {
+            const size_t count = out.size();
+            const float* g = out.grad();
+            const float* o = out.data();
+            std::vector<float> result(count);
+            for (size_t idx = 0; idx < count; ++idx) {
+                result[idx] = f(g[idx], o[idx]);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Adds gradients of a broadcast result (row-major, of `shape`) to `target`,
+         * summed over the dimensions along which `target` was repeated.
+         */
+        static void reduceInto(DenseTensor& target, const Shape& shape, const float* full) {
+            if (target._shape == shape) {
+                target.accumulate(full);
+                return;
+            }
+            const Broadcast plan(shape, target._shape);
+            const size_t n = plan.extents.back();
+            const bool step = plan.rhsStrides.back() != 0;
+            std::vector<float> reduced(target.size(), 0.0f);
+            float* t = reduced.data();
+            plan.forEachRow([&](size_t, size_t lhs, size_t rhs) {
+                const float* g = full + lhs;
+                if (step) {
+                    for (size_t idx = 0; idx < n; ++idx) {
+                        t[rhs + idx] += g[idx];
+                    }
+                } else {
+                    float total = 0.0f;
+                    for (size_t idx = 0; idx < n; ++idx) {
+                        total += g[idx];
+                    }
+                    t[rhs] += total;
+                }
+            });
+            target.accumulate(t);
+        }
+
+        /**
+         * @brief Records a tensor operation on the current tape, unless gradients are off.
+         * @param backward Adds the operation's gradients into its inputs.
+         * @param inputs Nodes the operation read, if any.
+         * @param outputs Nodes the operation created (TENSOR nodes), if any.
+         */
+        static void record(std::function<void()> backward, std::vector<uint32_t> inputs = {},
+                           std::vector<uint32_t> outputs = {}) {
+            if (!Autograd::isGradEnabled()) {
+                return;
+            }
+            Autograd::current().add_tensor_op({std::move(inputs), std::move(outputs), std::move(backward)});
+        }
+
+        /**
+         * @brief Records that `out` was read from `nodes`, one node per element.
+         */
+        static void readNodes(std::vector<uint32_t> nodes, const DenseTensor& out) {
+            if (!Autograd::isGradEnabled()) {
+                return;
+            }
+            // The closure reads the nodes from its own record, on the tape that recorded it
+            Autograd& tape = Autograd::current();
+            const size_t op = tape.tensorOps.size();
+            auto backward = [&tape, op, out]() {
+                const std::vector<uint32_t>& nodes = tape.tensorOps[op].inputs;
+                const float* g = out.grad();
+                for (size_t idx = 0; idx < nodes.size(); ++idx) {
+                    tape.node(nodes[idx]).grad += g[idx];
+                }
+            };
+            tape.add_tensor_op({std::move(nodes), {}, std::move(backward)});
+        }
+
+        /**
+         * @brief Appends one new node per element to `out` and records the conversion.
+         */
+        void writeNodes(Tensor1D& out) const {
+            // The nodes are TENSOR nodes only when the conversion is recorded
+            const bool recorded = Autograd::isGradEnabled();
+            const std::vector<float> data = values();
+            std::vector<uint32_t> nodes;
+            nodes.reserve(data.size());
+            out.reserve(data.size());
+            for (const float value : data) {
+                auto node = Value::createTransient(value, recorded ? OpCode::TENSOR : OpCode::LEAF);
+                nodes.push_back(node.index);
+                out.push_back(node);
+            }
+            if (!recorded) {
+                return;
+            }
+            Autograd& tape = Autograd::current();
+            const size_t op = tape.tensorOps.size();
+            auto backward = [&tape, op, in = *this]() mutable {
+                const std::vector<uint32_t>& nodes = tape.tensorOps[op].outputs;
+                std::vector<float> g(nodes.size());
+                for (size_t idx = 0; idx < nodes.size(); ++idx) {
+                    g[idx] = tape.node(nodes[idx]).grad;
+                }
+                in.accumulate(g.data());
+            };
+            tape.add_tensor_op({{}, std::move(nodes), std::move(backward)});
+        }
+    };
+
+} // namespace microgradpp
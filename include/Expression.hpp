@@ -0,0 +1,348 @@
+/**
+ *  @file Expression.hpp
+ *  @brief Expression templates that evaluate an arithmetic expression over Values as one graph node.
+ *
+ *  This file is part of the microgradpp project, a lightweight C++ library for neural
+ *  network training and inference.
+ *
+ *  @section License
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  @section Author
+ *  Gautam Sharma
+ *  Email: gautamsharma2813@gmail.com
+ *  Date: October 16, 2026
+ *
+ *  @details
+ *  Operators on `expr::var()` handles build an expression type instead of graph nodes:
+ *  @code
+ *  using namespace microgradpp;
+ *  auto d = expr::var(a) - expr::var(b);
+ *  ValueRef loss = expr::fuse(d * d);   // one node and one FUSED record
+ *  @endcode
+ *  `fuse()` evaluates the expression in one pass and records a single tape entry. Its
+ *  backward rule is generated from the expression type and registered once per type as a
+ *  FusedKernel. The leaves are the Values and float constants the expression was built
+ *  from; a Value that appears twice is two leaves whose gradients add up.
+ */
+
+#pragma once
+
+// Standard libraries
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+// microgradpp headers
+#include "Value.hpp"
+#include "TypeDefs.hpp"
+
+namespace microgradpp::expr {
+
+    /**
+     * @brief A Value read by the expression.
+     */
+    struct Leaf {
+        static constexpr uint32_t operands = 1;
+        static constexpr uint32_t constants = 0;
+
+        ValueRef ref; ///< The Value
+
+        template<uint32_t V, uint32_t C>
+        static float value(const float* values, const float*) {
+            return values[V];
+        }
+
+        template<uint32_t V, uint32_t C>
+        static void gradient(const float*, const float*, float grad, float* grads) {
+            grads[V] += grad;
+        }
+
+        template<uint32_t V, uint32_t C>
+        void collect(uint32_t* nodes, float* values, float*) const {
+            nodes[V] = ref.index;
+            values[V] = ref->data;
+        }
+    };
+
+    /**
+     * @brief A float constant of the expression, stored in the record rather than as a node.
+     */
+    struct Constant {
+        static constexpr uint32_t operands = 0;
+        static constexpr uint32_t constants = 1;
+
+        float constant; ///< The constant
+
+        template<uint32_t V, uint32_t C>
+        static float value(const float*, const float* constants) {
+            return constants[C];
+        }
+
+        template<uint32_t V, uint32_t C>
+        static void gradient(const float*, const float*, float, float*) {}
+
+        template<uint32_t V, uint32_t C>
+        void collect(uint32_t*, float*, float* constants) const {
+            constants[C] = constant;
+        }
+    };
+
+    /**
+     * @brief `Op` applied to two subexpressions.
+     *
+     * Leaves are numbered left to right: the operands and constants of `R` follow those of `L`.
+     * `Op` provides `value(l, r)` and the gradients `lhs(l, r, g)` and `rhs(l, r, g)`.
+     */
+    template<class Op, class L, class R>
+    struct Binary {
+        static constexpr uint32_t operands = L::operands + R::operands;
+        static constexpr uint32_t constants = L::constants + R::constants;
+
+        L lhs; ///< Left subexpression
+        R rhs; ///< Right subexpression
+
+        template<uint32_t V, uint32_t C>
+        static float value(const float* values, const float* constants) {
+            return Op::value(L::template value<V, C>(values, constants),
+                             R::template value<V + L::operands, C + L::constants>(values, constants));
+        }
+
+        template<uint32_t V, uint32_t C>
+        static void gradient(const float* values, const float* constants, float grad, float* grads) {
+            const float l = L::template value<V, C>(values, constants);
+            const float r = R::template value<V + L::operands, C + L::constants>(values, constants);
+            if constexpr (L::operands > 0) {
+                L::template gradient<V, C>(values, constants, Op::lhs(l, r, grad), grads);
+            }
+            if constexpr (R::operands > 0) {
+                R::template gradient<V + L::operands, C + L::constants>(values, constants, Op::rhs(l, r, grad), grads);
+            }
+        }
+
+        template<uint32_t V, uint32_t C>
+        void collect(uint32_t* nodes, float* values, float* constants) const {
+            lhs.template collect<V, C>(nodes, values, constants);
+            rhs.template collect<V + L::operands, C + L::constants>(nodes, values, constants);
+        }
+    };
+
+    /**
+     * @brief `Op` applied to one subexpression.
+     *
+     * `Op` provides `value(x)` and the gradient `derivative(x, out, g)`.
+     */
+    template<class Op, class A>
+    struct Unary {
+        static constexpr uint32_t operands = A::operands;
+        static constexpr uint32_t constants = A::constants;
+
+        A arg; ///< The subexpression
+
+        template<uint32_t V, uint32_t C>
+        static float value(const float* values, const float* constants) {
+            return Op::value(A::template value<V, C>(values, constants));
+        }
+
+        template<uint32_t V, uint32_t C>
+        static void gradient(const float* values, const float* constants, float grad, float* grads) {
+            const float x = A::template value<V, C>(values, constants);
+            A::template gradient<V, C>(values, constants, Op::derivative(x, Op::value(x), grad), grads);
+        }
+
+        template<uint32_t V, uint32_t C>
+        void collect(uint32_t* nodes, float* values, float* constants) const {
+            arg.template collect<V, C>(nodes, values, constants);
+        }
+    };
+
+    // Operations. Values and gradients are computed as the corresponding Value operations do.
+    struct Add {
+        static float value(float l, float r) { return l + r; }
+        static float lhs(float, float, float g) { return g; }
+        static float rhs(float, float, float g) { return g; }
+    };
+
+    struct Subtract {
+        static float value(float l, float r) { return l - r; }
+        static float lhs(float, float, float g) { return g; }
+        static float rhs(float, float, float g) { return -g; }
+    };
+
+    struct Multiply {
+        static float value(float l, float r) { return l * r; }
+        static float lhs(float, float r, float g) { return r * g; }
+        static float rhs(float l, float, float g) { return l * g; }
+    };
+
+    struct Divide {
+        static float value(float l, float r) { return l / r; }
+        static float lhs(float, float r, float g) { return g / r; }
+        static float rhs(float l, float r, float g) { return -l / (r * r) * g; }
+    };
+
+    struct Power { // The exponent is always a Constant
+        static float value(float l, float r) { return std::pow(l, r); }
+        static float lhs(float l, float r, float g) { return r * std::pow(l, r - 1) * g; }
+    };
+
+    struct Negate {
+        static float value(float x) { return -x; }
+        static float derivative(float, float, float g) { return -g; }
+    };
+
+    struct Tanh {
+        static float value(float x) { return (std::exp(2 * x) - 1) / (std::exp(2 * x) + 1); }
+        static float derivative(float, float t, float g) { return (1 - t * t) * g; }
+    };
+
+    struct ReLU {
+        static float value(float x) { return std::max(0.0f, x); }
+        static float derivative(float, float t, float g) { return static_cast<float>(t > 0) * g; }
+    };
+
+    struct Sigmoid {
+        static float value(float x) { return std::exp(x) / (1 + std::exp(x)); }
+        static float derivative(float, float t, float g) { return t * (1 - t) * g; }
+    };
+
+    /**
+     * @brief True for the expression types above.
+     */
+    template<class T>
+    struct IsExpression : std::false_type {};
+    template<> struct IsExpression<Leaf> : std::true_type {};
+    template<> struct IsExpression<Constant> : std::true_type {};
+    template<class Op, class L, class R> struct IsExpression<Binary<Op, L, R>> : std::true_type {};
+    template<class Op, class A> struct IsExpression<Unary<Op, A>> : std::true_type {};
+
+    template<class T>
+    constexpr bool isExpression = IsExpression<std::decay_t<T>>::value;
+
+    /**
+     * @brief True if an operator on L and R builds an expression: one side is an expression,
+     * the other an expression or a number.
+     */
+    template<class L, class R>
+    constexpr bool isOperation = (isExpression<L> && (isExpression<R> || std::is_arithmetic_v<std::decay_t<R>>))
+                                 || (isExpression<R> && std::is_arithmetic_v<std::decay_t<L>>);
+
+    /**
+     * @brief Turns a number into a Constant; expressions are returned as they are.
+     */
+    template<class T>
+    auto lift(const T& term) {
+        if constexpr (isExpression<T>) {
+            return term;
+        } else {
+            return Constant{static_cast<float>(term)};
+        }
+    }
+
+    template<class T>
+    using Term = decltype(lift(std::declval<T>()));
+
+    /**
+     * @brief Starts an expression from a Value.
+     */
+    inline Leaf var(const ValueRef& value) {
+        return Leaf{value};
+    }
+
+    template<class L, class R, class = std::enable_if_t<isOperation<L, R>>>
+    auto operator+(const L& lhs, const R& rhs) {
+        return Binary<Add, Term<L>, Term<R>>{lift(lhs), lift(rhs)};
+    }
+
+    template<class L, class R, class = std::enable_if_t<isOperation<L, R>>>
+    auto operator-(const L& lhs, const R& rhs) {
+        return Binary<Subtract, Term<L>, Term<R>>{lift(lhs), lift(rhs)};
+    }
+
+    template<class L, class R, class = std::enable_if_t<isOperation<L, R>>>
+    auto operator*(const L& lhs, const R& rhs) {
+        return Binary<Multiply, Term<L>, Term<R>>{lift(lhs), lift(rhs)};
+    }
+
+    template<class L, class R, class = std::enable_if_t<isOperation<L, R>>>
+    auto operator/(const L& lhs, const R& rhs) {
+        return Binary<Divide, Term<L>, Term<R>>{lift(lhs), lift(rhs)};
+    }
+
+    template<class A, class = std::enable_if_t<isExpression<A>>>
+    auto operator-(const A& arg) {
+        return Unary<Negate, A>{arg};
+    }
+
+    template<class A, class = std::enable_if_t<isExpression<A>>>
+    auto pow(const A& base, float exponent) {
+        return Binary<Power, A, Constant>{base, Constant{exponent}};
+    }
+
+    template<class A, class = std::enable_if_t<isExpression<A>>>
+    auto tanh(const A& arg) {
+        return Unary<Tanh, A>{arg};
+    }
+
+    template<class A, class = std::enable_if_t<isExpression<A>>>
+    auto relu(const A& arg) {
+        return Unary<ReLU, A>{arg};
+    }
+
+    template<class A, class = std::enable_if_t<isExpression<A>>>
+    auto sigmoid(const A& arg) {
+        return Unary<Sigmoid, A>{arg};
+    }
+
+    /**
+     * @brief Returns the id of the FusedKernel of expression type E, registering it on first use.
+     */
+    template<class E>
+    uint32_t kernel() {
+        static const uint32_t id = FusedKernel::add({
+            E::operands,
+            E::constants,
+            [](const float* values, const float* constants) {
+                return E::template value<0, 0>(values, constants);
+            },
+            [](const float* values, const float* constants, float grad, float* grads) {
+                std::fill(grads, grads + E::operands, 0.0f);
+                E::template gradient<0, 0>(values, constants, grad, grads);
+            }
+        });
+        return id;
+    }
+
+    /**
+     * @brief Evaluates an expression as a single graph node.
+     * @param expression The expression.
+     * @return A handle to the new Value holding the result.
+     */
+    template<class E, class = std::enable_if_t<isExpression<E>>>
+    ValueRef fuse(const E& expression) {
+        static_assert(E::operands > 0, "a fused expression must read at least one Value");
+        static_assert(E::operands <= FusedKernel::MAX_OPERANDS && E::constants <= FusedKernel::MAX_OPERANDS,
+                      "expression too large to fuse, split it");
+        uint32_t nodes[E::operands];
+        float values[E::operands];
+        float constants[E::constants + 1];
+        expression.template collect<0, 0>(nodes, values, constants);
+
+        auto out = Value::createTransient(E::template value<0, 0>(values, constants), OpCode::FUSED);
+        Autograd::current().add_fused_entry(out.index, kernel<E>(), nodes, constants);
+        return out;
+    }
+
+} // namespace microgradpp::expr
@@ -0,0 +1,132 @@
+/**
+ *  @file ForwardMode.hpp
+ *  @brief Forward-mode differentiation of models through dual-number nodes.
+ *
+ *  This file is part of the microgradpp project, a lightweight C++ library for neural
+ *  network training and inference.
+ *
+ *  @section License
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  @section Author
+ *  Gautam Sharma
+ *  Email: gautamsharma2813@gmail.com
+ *  Date: October 16, 2026
+ *
+ *  @details
+ *  A model built on `Dual<T>` nodes (`nn::Linear<Dual<float>>(...)` and so on) evaluates
+ *  derivatives together with values: seeding the inputs with tangents v makes the output
+ *  tangents the Jacobian-vector product J v. Nothing is recorded on a tape, so one
+ *  directional derivative costs about two forward passes and memory does not grow with
+ *  the graph. Reverse mode remains the better choice when many inputs or all parameters
+ *  need gradients; forward mode wins for a handful of input directions.
+ *  @code
+ *  using D = Dual<float>;
+ *  core::BasicSequential<D> dual({nn::Linear<D>(3, 8), nn::TanH<D>(), nn::Linear<D>(8, 1)});
+ *  copyParameters(trained, dual);                 // trained: a float Sequential
+ *  auto result = jvp(dual, {1, 2, 3}, {1, 0, 0});  // d outputs / d x0
+ *  @endcode
+ */
+
+#pragma once
+
+// Standard libraries
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// microgradpp headers
+#include "Scalar.hpp"
+#include "Value.hpp"
+#include "Tensor.hpp"
+
+namespace microgradpp {
+
+    template<class T = float>
+    using DualValue = BasicValue<Dual<T>>;
+
+    template<class T = float>
+    using DualTensor1D = BasicTensor1D<Dual<T>>;
+
+    /**
+     * @brief Outputs of a model and their derivatives along one input direction.
+     */
+    template<class T>
+    struct JacobianVectorProduct {
+        std::vector<T> values;   ///< Model outputs f(x)
+        std::vector<T> tangents; ///< Directional derivatives J(x) v
+    };
+
+    /**
+     * @brief Evaluates a dual-number model at x and its Jacobian along v.
+     *
+     * The nodes created by the pass are released before returning.
+     *
+     * @tparam Model Any callable taking and returning a DualTensor1D<T>.
+     * @param model The model.
+     * @param x The point to evaluate at.
+     * @param v The input direction, same length as x.
+     * @return The outputs and the Jacobian-vector product.
+     * @throws std::invalid_argument If x and v differ in length.
+     */
+    template<class Model, class T>
+    JacobianVectorProduct<T> jvp(Model&& model, const std::vector<T>& x, const std::vector<T>& v) {
+        if (x.size() != v.size()) {
+            throw std::invalid_argument("Error in microgradpp::jvp -> point and direction must be of the same length");
+        }
+        auto& arena = BasicAutograd<DualValue<T>>::current().arena;
+        const uint32_t mark = arena.size();
+
+        DualTensor1D<T> in;
+        in.reserve(x.size());
+        for (size_t idx = 0; idx < x.size(); ++idx) {
+            in.push_back(DualValue<T>::createTransient(Dual<T>(x[idx], v[idx])));
+        }
+
+        JacobianVectorProduct<T> out;
+        for (const auto& value : model(in)) {
+            out.values.push_back(value->data.value);
+            out.tangents.push_back(value->data.tangent);
+        }
+        arena.rewind(mark);
+        return out;
+    }
+
+    /**
+     * @brief Copies the parameter values of one model into a model of another scalar type.
+     *
+     * Use it to differentiate a trained float model in forward mode, or to continue
+     * training in another precision. Gradients are not copied.
+     *
+     * @tparam Source A model with `parameters()` (a layer or Sequential).
+     * @tparam Target A model of the same architecture.
+     * @param source The model to read.
+     * @param target The model to write.
+     * @throws std::invalid_argument If the models have different parameter counts.
+     */
+    template<class Source, class Target>
+    void copyParameters(const Source& source, Target& target) {
+        const auto from = source.parameters();
+        const auto to = target.parameters();
+        if (from.size() != to.size()) {
+            throw std::invalid_argument("Error in microgradpp::copyParameters -> models have different parameter counts");
+        }
+        using From = typename std::remove_pointer_t<typename decltype(from)::value_type>::Compute;
+        using To = typename std::remove_pointer_t<typename decltype(to)::value_type>::Compute;
+        for (size_t idx = 0; idx < from.size(); ++idx) {
+            to[idx]->data = static_cast<To>(static_cast<From>(from[idx]->data));
+        }
+    }
+
+} // namespace microgradpp
@@ -0,0 +1,334 @@
+/**
+ *  @file Gemm.hpp
+ *  @brief Single-precision matrix multiplication with packed, cache-blocked SIMD kernels.
+ *
+ *  This file is part of the microgradpp project, a lightweight C++ library for neural
+ *  network training and inference.
+ *
+ *  @section License
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  @section Author
+ *  Gautam Sharma
+ *  Email: gautamsharma2813@gmail.com
+ *  Date: October 16, 2026
+ *
+ *  @details
+ *  `gemm::sgemm` computes `C += op(A) * op(B)` for row-major matrices, where op() optionally
+ *  transposes. A layer uses three variants: the forward pass `Y = X * W^T` (NT), the input
+ *  gradient `dX = dY * W` (NN) and the weight gradient `dW = dY^T * X` (TN).
+ *
+ *  The product is computed in blocks sized for the caches: a KC x NC panel of B and an
+ *  MC x KC block of A are copied ("packed") into contiguous buffers laid out in the order
+ *  the micro-kernel reads them, and the micro-kernel accumulates an MR x NR tile of C in
+ *  registers. Three micro-kernels exist, chosen once at run time from the CPU's features:
+ *  AVX-512 (6 x 32), AVX2 with FMA (6 x 16) and portable C++ (6 x 16). The SIMD kernels are
+ *  compiled with function-level target attributes, so no architecture flags are needed and
+ *  the same binary runs on any x86-64 CPU.
+ */
+
+#pragma once
+
+// Standard libraries
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MICROGRADPP_GEMM_X86 1
+#include <immintrin.h>
+#endif
+
+namespace microgradpp::gemm {
+
+    /**
+     * @brief The micro-kernels sgemm can run.
+     */
+    enum class Kernel {
+        PORTABLE, ///< Plain C++, any CPU
+        AVX2,     ///< AVX2 and FMA
+        AVX512    ///< AVX-512F
+    };
+
+    constexpr size_t MR = 6;      ///< Rows of C per micro-tile (all kernels)
+    constexpr size_t MAX_NR = 32; ///< Widest micro-tile (AVX-512)
+    constexpr size_t MC = 144;    ///< Rows of A per packed block, a multiple of MR
+    constexpr size_t KC = 256;    ///< Depth of the packed blocks
+    constexpr size_t NC = 3072;   ///< Columns of B per packed panel, a multiple of every NR
+
+    /**
+     * @brief Micro-kernel: C[MR x NR] += A * B for a packed A panel (MR values per step) and
+     * a packed B panel (NR values per step), `kc` steps deep.
+     */
+    using MicroKernel = void (*)(size_t kc, const float* a, const float* b, float* c, size_t ldc);
+
+    /**
+     * @brief Returns the width NR of the micro-tiles of a kernel.
+     */
+    inline size_t tileWidth(Kernel kernel) {
+        return kernel == Kernel::AVX512 ? 32 : 16;
+    }
+
+    namespace detail {
+
+        inline void kernelPortable(size_t kc, const float* a, const float* b, float* c, size_t ldc) {
+            constexpr size_t NR = 16;
+            float acc[MR][NR] = {};
+            for (size_t p = 0; p < kc; ++p) {
+                for (size_t i = 0; i < MR; ++i) {
+                    const float aI = a[i];
+                    for (size_t j = 0; j < NR; ++j) {
+                        acc[i][j] += aI * b[j];
+                    }
+                }
+                a += MR;
+                b += NR;
+            }
+            for (size_t i = 0; i < MR; ++i) {
+                for (size_t j = 0; j < NR; ++j) {
+                    c[i * ldc + j] += acc[i][j];
+                }
+            }
+        }
+
+#ifdef MICROGRADPP_GEMM_X86
+        __attribute__((target("avx2,fma")))
+        inline void kernelAvx2(size_t kc, const float* a, const float* b, float* c, size_t ldc) {
+            __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+            __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+            __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+            __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+            __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+            __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+            for (size_t p = 0; p < kc; ++p) {
+                const __m256 b0 = _mm256_loadu_ps(b);
+                const __m256 b1 = _mm256_loadu_ps(b + 8);
+                __m256 aI = _mm256_broadcast_ss(a);
+                c00 = _mm256_fmadd_ps(aI, b0, c00);
+                c01 = _mm256_fmadd_ps(aI, b1, c01);
+                aI = _mm256_broadcast_ss(a + 1);
+                c10 = _mm256_fmadd_ps(aI, b0, c10);
+                c11 = _mm256_fmadd_ps(aI, b1, c11);
+                aI = _mm256_broadcast_ss(a + 2);
+                c20 = _mm256_fmadd_ps(aI, b0, c20);
+                c21 = _mm256_fmadd_ps(aI, b1, c21);
+                aI = _mm256_broadcast_ss(a + 3);
+                c30 = _mm256_fmadd_ps(aI, b0, c30);
+                c31 = _mm256_fmadd_ps(aI, b1, c31);
+                aI = _mm256_broadcast_ss(a + 4);
+                c40 = _mm256_fmadd_ps(aI, b0, c40);
+                c41 = _mm256_fmadd_ps(aI, b1, c41);
+                aI = _mm256_broadcast_ss(a + 5);
+                c50 = _mm256_fmadd_ps(aI, b0, c50);
+                c51 = _mm256_fmadd_ps(aI, b1, c51);
+                a += MR;
+                b += 16;
+            }
+            const __m256 rows[MR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}};
+            for (size_t i = 0; i < MR; ++i) {
+                float* cI = c + i * ldc;
+                _mm256_storeu_ps(cI, _mm256_add_ps(_mm256_loadu_ps(cI), rows[i][0]));
+                _mm256_storeu_ps(cI + 8, _mm256_add_ps(_mm256_loadu_ps(cI + 8), rows[i][1]));
+            }
+        }
+
+        __attribute__((target("avx512f")))
+        inline void kernelAvx512(size_t kc, const float* a, const float* b, float* c, size_t ldc) {
+            __m512 c00 = _mm512_setzero_ps(), c01 = _mm512_setzero_ps();
+            __m512 c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+            __m512 c20 = _mm512_setzero_ps(), c21 = _mm512_setzero_ps();
+            __m512 c30 = _mm512_setzero_ps(), c31 = _mm512_setzero_ps();
+            __m512 c40 = _mm512_setzero_ps(), c41 = _mm512_setzero_ps();
+            __m512 c50 = _mm512_setzero_ps(), c51 = _mm512_setzero_ps();
+            for (size_t p = 0; p < kc; ++p) {
+                const __m512 b0 = _mm512_loadu_ps(b);
+                const __m512 b1 = _mm512_loadu_ps(b + 16);
+                __m512 aI = _mm512_set1_ps(a[0]);
+                c00 = _mm512_fmadd_ps(aI, b0, c00);
+                c01 = _mm512_fmadd_ps(aI, b1, c01);
+                aI = _mm512_set1_ps(a[1]);
+                c10 = _mm512_fmadd_ps(aI, b0, c10);
+                c11 = _mm512_fmadd_ps(aI, b1, c11);
+                aI = _mm512_set1_ps(a[2]);
+                c20 = _mm512_fmadd_ps(aI, b0, c20);
+                c21 = _mm512_fmadd_ps(aI, b1, c21);
+                aI = _mm512_set1_ps(a[3]);
+                c30 = _mm512_fmadd_ps(aI, b0, c30);
+                c31 = _mm512_fmadd_ps(aI, b1, c31);
+                aI = _mm512_set1_ps(a[4]);
+                c40 = _mm512_fmadd_ps(aI, b0, c40);
+                c41 = _mm512_fmadd_ps(aI, b1, c41);
+                aI = _mm512_set1_ps(a[5]);
+                c50 = _mm512_fmadd_ps(aI, b0, c50);
+                c51 = _mm512_fmadd_ps(aI, b1, c51);
+                a += MR;
+                b += 32;
+            }
+            const __m512 rows[MR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}};
+            for (size_t i = 0; i < MR; ++i) {
+                float* cI = c + i * ldc;
+                _mm512_storeu_ps(cI, _mm512_add_ps(_mm512_loadu_ps(cI), rows[i][0]));
+                _mm512_storeu_ps(cI + 16, _mm512_add_ps(_mm512_loadu_ps(cI + 16), rows[i][1]));
+            }
+        }
+#endif
+
+        inline MicroKernel microKernel(Kernel kernel) {
+#ifdef MICROGRADPP_GEMM_X86
+            if (kernel == Kernel::AVX512) {
+                return kernelAvx512;
+            }
+            if (kernel == Kernel::AVX2) {
+                return kernelAvx2;
+            }
+#endif
+            return kernelPortable;
+        }
+
+        /**
+         * @brief Packs rows [row, row + mc) x columns [column, column + kc) of op(A) into
+         * MR-row panels, each stored step by step (MR values per step), zero-padded.
+         */
+        inline void packA(bool transpose, const float* a, size_t lda, size_t row, size_t column,
+                          size_t mc, size_t kc, float* packed) {
+            for (size_t ir = 0; ir < mc; ir += MR) {
+                const size_t rows = std::min(MR, mc - ir);
+                for (size_t p = 0; p < kc; ++p) {
+                    for (size_t i = 0; i < rows; ++i) {
+                        const size_t r = row + ir + i, c = column + p;
+                        packed[i] = transpose ? a[c * lda + r] : a[r * lda + c];
+                    }
+                    for (size_t i = rows; i < MR; ++i) {
+                        packed[i] = 0.0f;
+                    }
+                    packed += MR;
+                }
+            }
+        }
+
+        /**
+         * @brief Packs rows [row, row + kc) x columns [column, column + nc) of op(B) into
+         * nr-column panels, each stored step by step (nr values per step), zero-padded.
+         */
+        inline void packB(bool transpose, const float* b, size_t ldb, size_t row, size_t column,
+                          size_t kc, size_t nc, size_t nr, float* packed) {
+            for (size_t jr = 0; jr < nc; jr += nr) {
+                const size_t columns = std::min(nr, nc - jr);
+                for (size_t p = 0; p < kc; ++p) {
+                    const size_t r = row + p;
+                    if (transpose) {
+                        for (size_t j = 0; j < columns; ++j) {
+                            packed[j] = b[(column + jr + j) * ldb + r];
+                        }
+                    } else {
+                        std::memcpy(packed, b + r * ldb + column + jr, columns * sizeof(float));
+                    }
+                    for (size_t j = columns; j < nr; ++j) {
+                        packed[j] = 0.0f;
+                    }
+                    packed += nr;
+                }
+            }
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Returns true if the CPU can run a kernel.
+     */
+    inline bool supported(Kernel kernel) {
+#ifdef MICROGRADPP_GEMM_X86
+        __builtin_cpu_init();
+        switch (kernel) {
+            case Kernel::AVX512:
+                return __builtin_cpu_supports("avx512f");
+            case Kernel::AVX2:
+                return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+            default:
+                return true;
+        }
+#else
+        return kernel == Kernel::PORTABLE;
+#endif
+    }
+
+    /**
+     * @brief Returns the fastest kernel the CPU supports, detected once.
+     */
+    inline Kernel best() {
+        static const Kernel detected = supported(Kernel::AVX512) ? Kernel::AVX512
+                                     : supported(Kernel::AVX2) ? Kernel::AVX2
+                                     : Kernel::PORTABLE;
+        return detected;
+    }
+
+    /**
+     * @brief C += op(A) * op(B) for row-major matrices.
+     *
+     * op(A) is m x k and op(B) is k x n. Element (i, p) of op(A) is `a[i * lda + p]`, or
+     * `a[p * lda + i]` when `transposeA` is set; likewise for B. C is m x n with rows
+     * `ldc` apart and must not overlap A or B.
+     *
+     * @param transposeA Use the transpose of the stored A.
+     * @param transposeB Use the transpose of the stored B.
+     * @param kernel The micro-kernel to run, best() by default; it must be supported().
+     */
+    inline void sgemm(bool transposeA, bool transposeB, size_t m, size_t n, size_t k,
+                      const float* a, size_t lda, const float* b, size_t ldb, float* c, size_t ldc,
+                      Kernel kernel = best()) {
+        if (m == 0 || n == 0 || k == 0) {
+            return;
+        }
+        const MicroKernel micro = detail::microKernel(kernel);
+        const size_t nr = tileWidth(kernel);
+        thread_local std::vector<float> packedA, packedB;
+        packedA.resize(MC * KC);
+        packedB.resize(KC * NC);
+
+        for (size_t jc = 0; jc < n; jc += NC) {
+            const size_t nc = std::min(NC, n - jc);
+            for (size_t pc = 0; pc < k; pc += KC) {
+                const size_t kc = std::min(KC, k - pc);
+                detail::packB(transposeB, b, ldb, pc, jc, kc, nc, nr, packedB.data());
+                for (size_t ic = 0; ic < m; ic += MC) {
+                    const size_t mc = std::min(MC, m - ic);
+                    detail::packA(transposeA, a, lda, ic, pc, mc, kc, packedA.data());
+                    for (size_t jr = 0; jr < nc; jr += nr) {
+                        const size_t columns = std::min(nr, nc - jr);
+                        const float* bPanel = packedB.data() + jr * kc;
+                        for (size_t ir = 0; ir < mc; ir += MR) {
+                            const size_t rows = std::min(MR, mc - ir);
+                            const float* aPanel = packedA.data() + ir * kc;
+                            float* cTile = c + (ic + ir) * ldc + jc + jr;
+                            if (rows == MR && columns == nr) {
+                                micro(kc, aPanel, bPanel, cTile, ldc);
+                                continue;
+                            }
+                            // Edge tile: compute a full tile aside and add the part inside C
+                            float tile[MR * MAX_NR] = {};
+                            micro(kc, aPanel, bPanel, tile, nr);
+                            for (size_t i = 0; i < rows; ++i) {
+                                for (size_t j = 0; j < columns; ++j) {
+                                    cTile[i * ldc + j] += tile[i * nr + j];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace microgradpp::gemm
@@ -0,0 +1,97 @@
+/**
+ *  @file GradientAccumulation.hpp
+ *  @brief Accumulates parameter gradients over micro-batches without keeping their graphs.
+ *
+ *  This file is part of the microgradpp project, a lightweight C++ library for neural
+ *  network training and inference.
+ *
+ *  @section License
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  @section Author
+ *  Gautam Sharma
+ *  Email: gautamsharma2813@gmail.com
+ *  Date: October 16, 2026
+ *
+ *  @details
+ *  A training step over a large batch normally builds one graph covering every sample, so
+ *  peak memory grows with the batch. Splitting the batch into micro-batches and calling
+ *  `accumulate()` on each one back-propagates a micro-batch and discards its graph right
+ *  away; only the parameter gradients, which add up, are carried to the next one:
+ *  @code
+ *  mlp.zeroGrad();
+ *  for (size_t idx = 0; idx < xBatches.size(); ++idx) {
+ *      mlp.accumulate(xBatches[idx], yBatches[idx], lossFcn);
+ *  }
+ *  mlp.update();
+ *  @endcode
+ *  Peak memory then depends on the micro-batch size only. With a loss that sums over the
+ *  samples (as MeanSquaredError does) the accumulated gradients equal those of the whole
+ *  batch; pass `scale` to average instead.
+ */
+
+#pragma once
+
+// Standard libraries
+#include <stdexcept>
+
+// microgradpp headers
+#include "AbstractLoss.hpp"
+#include "Autograd.hpp"
+#include "Tensor.hpp"
+
+namespace microgradpp {
+
+    /**
+     * @brief Adds the gradients of one micro-batch into the parameters of a model.
+     *
+     * Runs the model on every row of `xs`, computes the loss against `ys`, back-propagates
+     * `scale * loss` and discards everything the pass recorded, leaving the tape as it was.
+     * Gradients are added to the existing ones, so call `zeroGrad()` before the first
+     * micro-batch of a step.
+     *
+     * @tparam Model Any callable taking and returning a Tensor1D.
+     * @tparam Tensor2D The tensor type of the model (BasicTensor2D<S>).
+     * @param model The model.
+     * @param xs Inputs of the micro-batch, one row per sample.
+     * @param ys Targets of the micro-batch.
+     * @param lossFcn The loss function.
+     * @param scale Factor applied to the loss gradient, e.g. 1 / number of micro-batches.
+     * @return The loss of the micro-batch.
+     * @throws std::logic_error In inference mode or for forward-mode models.
+     */
+    template<class Model, class Tensor2D>
+    typename Tensor2D::Compute accumulateGradients(Model&& model, const Tensor2D& xs, const Tensor2D& ys,
+                                                   AbstractLoss<Tensor2D>& lossFcn,
+                                                   typename Tensor2D::Compute scale = 1) {
+        using Tape = BasicAutograd<typename Tensor2D::Value>;
+        if (!Tape::isGradEnabled()) {
+            throw std::logic_error("Error in microgradpp::accumulateGradients -> gradients are not recorded");
+        }
+
+        auto& tape = Tape::current();
+        const TapePosition start = tape.position();
+        Tensor2D predictions;
+        for (const auto& input : xs) {
+            predictions.push_back(model(input));
+        }
+        auto loss = lossFcn(ys, predictions);
+        const typename Tensor2D::Compute value = loss->data;
+        loss->grad = scale;
+        tape.backward(loss.index);
+        tape.rewind(start);
+        return value;
+    }
+
+} // namespace microgradpp
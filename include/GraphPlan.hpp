@@ -0,0 +1,325 @@
+/**
+ *  @file GraphPlan.hpp
+ *  @brief Defines GraphPlan, a captured training graph that is replayed without rebuilding it.
+ *
+ *  This file is part of the microgradpp project, a lightweight C++ library for neural
+ *  network training and inference.
+ *
+ *  @section License
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  @section Author
+ *  Gautam Sharma
+ *  Email: gautamsharma2813@gmail.com
+ *  Date: October 16, 2026
+ *
+ *  @details
+ *  When the shape of a training step does not change between iterations, the graph built
+ *  by the forward pass and the loss is the same every time. A GraphPlan records that graph
+ *  once; each replay writes new input values into the plan's input slots, re-evaluates the
+ *  recorded operations in place and runs the backward rules over them. No node is created
+ *  and nothing is appended to the current tape, so `Autograd::clear()` does not affect a plan.
+ *  A plan can also be compiled to native code (see PlanCompiler), which then replaces the
+ *  interpreter for every replay.
+ */
+
+#pragma once
+
+// Standard libraries
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// microgradpp headers
+#include "Value.hpp"
+#include "Tensor.hpp"
+#include "AbstractLoss.hpp"
+#include "TapeOptimizer.hpp"
+#include "PlanCompiler.hpp"
+#include "TypeDefs.hpp"
+
+namespace microgradpp {
+
+    /**
+     * @class GraphPlan
+     * @brief A forward + loss graph captured once and replayed with new data.
+     *
+     * Create a plan with `BaseMultiLayerPerceptron::capture()`. A typical training step is:
+     * @code
+     * auto plan = mlp->capture(xs, ys, lossFcn);
+     * for (...) {
+     *     float loss = plan.forward(xs, ys);
+     *     mlp->zeroGrad();
+     *     plan.backward();
+     *     mlp->update();
+     * }
+     * @endcode
+     * The plan refers to the model's parameters, so the model must outlive it.
+     */
+    class GraphPlan {
+    private:
+        Tensor2D _inputs;                 ///< Input slots, written by forward()
+        Tensor2D _targets;                ///< Target slots, written by forward()
+        Tensor2D _outputs;                ///< Model outputs of the captured graph
+        ValueRef _loss;                   ///< Loss node of the captured graph
+        std::vector<TapeEntry> _tape;     ///< Operations of the captured graph
+        std::vector<uint32_t> _operands;  ///< Operand lists of the captured n-ary operations
+        std::vector<uint32_t> _nodes;     ///< Intermediate nodes owned by the plan
+        NativePlan _native;               ///< Compiled records, when compile() succeeded
+        std::vector<void*> _addresses;    ///< Node addresses used by the compiled records
+
+    public:
+        GraphPlan() = default;
+        GraphPlan(const GraphPlan&) = delete;
+        GraphPlan& operator=(const GraphPlan&) = delete;
+
+        GraphPlan(GraphPlan&& other) noexcept
+                : _inputs(std::move(other._inputs)), _targets(std::move(other._targets)),
+                  _outputs(std::move(other._outputs)), _loss(other._loss),
+                  _tape(std::move(other._tape)), _operands(std::move(other._operands)),
+                  _nodes(std::move(other._nodes)), _native(std::move(other._native)),
+                  _addresses(std::move(other._addresses)) {
+            other._nodes.clear();
+        }
+
+        GraphPlan& operator=(GraphPlan&& other) noexcept {
+            if (this != &other) {
+                release();
+                _inputs = std::move(other._inputs);
+                _targets = std::move(other._targets);
+                _outputs = std::move(other._outputs);
+                _loss = other._loss;
+                _tape = std::move(other._tape);
+                _operands = std::move(other._operands);
+                _nodes = std::move(other._nodes);
+                _native = std::move(other._native);
+                _addresses = std::move(other._addresses);
+                other._nodes.clear();
+            }
+            return *this;
+        }
+
+        ~GraphPlan() {
+            release();
+        }
+
+        /**
+         * @brief Records one pass of `model` over `xs` and the loss against `ys`.
+         *
+         * @tparam Model Any callable taking a Tensor1D and returning a Tensor1D.
+         * @param model The model to capture.
+         * @param xs Inputs with the shape every replay will use.
+         * @param ys Targets with the shape every replay will use.
+         * @param lossFcn The loss function.
+         * @return The captured plan.
+         * @throws std::logic_error In inference mode, or if the pass recorded checkpointed
+         *         segments or dense tensor operations.
+         *
+         * If the pass throws, everything it recorded is discarded from the tape.
+         */
+        template<class Model>
+        static GraphPlan capture(Model&& model, const Tensor2D& xs, const Tensor2D& ys, AbstractLoss<Tensor2D>& lossFcn) {
+            if (!Autograd::isGradEnabled()) {
+                throw std::logic_error("Error in microgradpp::GraphPlan -> cannot capture in inference mode");
+            }
+
+            GraphPlan plan;
+            plan._inputs = copy(xs);
+            plan._targets = copy(ys);
+
+            auto& tape = Autograd::current();
+            const TapePosition start = tape.position();
+            tape.captured = &plan._nodes;
+            try {
+                for (const auto& row : plan._inputs) {
+                    plan._outputs.push_back(model(row));
+                }
+                plan._loss = lossFcn(plan._targets, plan._outputs);
+            } catch (...) {
+                tape.captured = nullptr;
+                tape.rewind(start);
+                throw;
+            }
+            tape.captured = nullptr;
+            if (tape.checkpoints.size() != start.checkpoints || tape.tensorOps.size() != start.tensorOps) {
+                tape.rewind(start);
+                throw std::logic_error("Error in microgradpp::GraphPlan -> cannot capture checkpoints or dense tensor operations");
+            }
+
+            plan._tape.assign(tape.tape.begin() + static_cast<std::ptrdiff_t>(start.records), tape.tape.end());
+            plan._operands.assign(tape.operands.begin() + static_cast<std::ptrdiff_t>(start.operands), tape.operands.end());
+            for (auto& entry : plan._tape) {
+                if (Autograd::isNary(entry)) {
+                    entry.lhs -= static_cast<uint32_t>(start.operands);
+                }
+            }
+            tape.rewind(start);
+            return plan;
+        }
+
+        /**
+         * @brief Replays the forward pass and the loss with new data.
+         * @param xs Inputs, with the shape used at capture.
+         * @param ys Targets, with the shape used at capture.
+         * @return The loss.
+         * @throws std::invalid_argument If the shapes differ from the captured ones.
+         */
+        float forward(const Tensor2D& xs, const Tensor2D& ys) {
+            write(_inputs, xs);
+            write(_targets, ys);
+            if (_native) {
+                _native.forward(_addresses.data());
+            } else {
+                Autograd::current().forward(_tape, _operands);
+            }
+            return _loss->data;
+        }
+
+        /**
+         * @brief Back-propagates the loss of the last forward() into the model parameters.
+         *
+         * Gradients of the plan's own nodes are reset first; parameter gradients accumulate
+         * as with `Value::backProp()`, so call `zeroGrad()` on the model beforehand.
+         */
+        void backward() {
+            auto& tape = Autograd::current();
+            for (const uint32_t index : _nodes) {
+                tape.node(index).grad = 0.0f;
+            }
+            _inputs.zeroGrad();
+            _targets.zeroGrad();
+            _loss->grad = 1.0f;
+            if (_native) {
+                _native.backward(_addresses.data());
+            } else {
+                tape.backward(_tape, _operands);
+            }
+        }
+
+        /**
+         * @brief Rewrites the captured graph into a shorter one with the same outputs, loss
+         * and parameter gradients (see TapeOptimizer). Call once after capture; every later
+         * replay runs the optimized records. Drops the compiled records, if any.
+         * @return What was changed.
+         */
+        TapeOptimizerStats optimize() {
+            _native = NativePlan();
+            _addresses.clear();
+            std::vector<uint32_t> keep{_loss.index};
+            for (const auto& row : _outputs) {
+                for (const auto& value : row) {
+                    keep.push_back(value.index);
+                }
+            }
+            return TapeOptimizer(keep).run(_tape, _operands);
+        }
+
+        /**
+         * @brief Compiles the records to native code and replays them natively from then on.
+         *
+         * The first call for a given graph runs the system compiler; later calls, also from
+         * other processes, load the cached object. Native replays give the same results as
+         * the interpreter. Call optimize() first if the plan is to be optimized.
+         *
+         * @return true if native code is in use, false if the plan keeps being interpreted
+         *         (no compiler or dynamic loader, or the plan holds checkpoints or fused expressions).
+         */
+        bool compile() {
+            std::vector<uint32_t> nodes;
+            NativePlan native = PlanCompiler::load(PlanCompiler::generate(_tape, _operands, nodes));
+            if (!native) {
+                return false;
+            }
+            auto& tape = Autograd::current();
+            _addresses.clear();
+            _addresses.reserve(nodes.size());
+            for (const uint32_t index : nodes) {
+                _addresses.push_back(&tape.node(index));
+            }
+            _native = std::move(native);
+            return true;
+        }
+
+        /**
+         * @brief Returns true if replays run compiled code.
+         */
+        __MICROGRADPP_NO_DISCARD__
+        bool compiled() const {
+            return static_cast<bool>(_native);
+        }
+
+        /**
+         * @brief Returns the model outputs computed by the last forward().
+         */
+        __MICROGRADPP_NO_DISCARD__
+        const Tensor2D& outputs() const {
+            return _outputs;
+        }
+
+        /**
+         * @brief Returns the loss node of the plan.
+         */
+        __MICROGRADPP_NO_DISCARD__
+        ValueRef loss() const {
+            return _loss;
+        }
+
+        /**
+         * @brief Returns the number of operations replayed per pass.
+         */
+        __MICROGRADPP_NO_DISCARD__
+        size_t size() const {
+            return _tape.size();
+        }
+
+    private:
+        static Tensor2D copy(const Tensor2D& source) {
+            Tensor2D out;
+            for (const auto& row : source) {
+                std::vector<float> values;
+                values.reserve(row.size());
+                for (const auto& value : row) {
+                    values.push_back(value->data);
+                }
+                out.push_back(Tensor1D(values));
+            }
+            return out;
+        }
+
+        static void write(Tensor2D& slots, const Tensor2D& source) {
+            if (slots.size() != source.size()) {
+                throw std::invalid_argument("Error in microgradpp::GraphPlan -> data shape differs from the captured one");
+            }
+            for (size_t idx = 0; idx < slots.size(); ++idx) {
+                const auto& slotRow = slots[idx];
+                const auto& sourceRow = source[idx];
+                if (slotRow.size() != sourceRow.size()) {
+                    throw std::invalid_argument("Error in microgradpp::GraphPlan -> data shape differs from the captured one");
+                }
+                for (size_t jdx = 0; jdx < slotRow.size(); ++jdx) {
+                    slotRow[jdx]->data = sourceRow[jdx]->data;
+                }
+            }
+        }
+
+        void release() noexcept {
+            auto& tape = Autograd::current();
+            for (const uint32_t index : _nodes) {
+                tape.releasePersistent(index);
+            }
+            _nodes.clear();
+        }
+    };
+
+} // namespace microgradpp
@@ -35,28 +35,48 @@
 
 // stdlibs
 #include <cassert>
+#include <type_traits>
 
 #include "AbstractLoss.hpp"
 #include "Tensor.hpp"
+#ifdef MICROGRADPP_FUSED_EXPRESSIONS
+#include "Expression.hpp"
+#endif
 
 namespace microgradpp::loss{
 
-    class MeanSquaredError : public AbstractLoss<Tensor2D>{
+    /**
+     * @brief Sum of squared differences between predictions and ground truth.
+     * @tparam S The scalar type of the tensors (see BasicValue).
+     */
+    template<class S>
+    class BasicMeanSquaredError : public AbstractLoss<BasicTensor2D<S>>{
     public:
-        MeanSquaredError () = default;
+        using Value = BasicValue<S>;
+        using ValueRef = BasicValueRef<S>;
+        using Tensor2D = BasicTensor2D<S>;
+
+        BasicMeanSquaredError () = default;
 
         /**
          * @brief Computes the mean squared error loss between ground truth and predictions.
          * 
          * @param groundTruth The true values.
          * @param prediction The predicted values.
-         * @return ValuePtr The computed mean squared error loss.
+         * @return ValueRef The computed mean squared error loss.
          */
-        ValuePtr operator()(const Tensor2D& groundTruth, const Tensor2D& prediction) override{
+        ValueRef operator()(const Tensor2D& groundTruth, const Tensor2D& prediction) override{
             // Calculate loss
-            auto loss = Value::create(0.0f);
+            auto loss = Value::createTransient(0);
             assert(groundTruth.size() == prediction.size());
             for (size_t i = 0; i < groundTruth.size(); ++i) {
+#ifdef MICROGRADPP_FUSED_EXPRESSIONS
+                if constexpr (std::is_same_v<S, float>) { // Fused kernels compute in float
+                    const auto c = expr::var(groundTruth.at(i)) - expr::var(prediction.at(i));
+                    loss = expr::fuse(expr::var(loss) + c * c);
+                    continue;
+                }
+#endif
                 auto c = Value::subtract(groundTruth.at(i) , prediction.at(i));
                 auto b = Value::multiply(c, c);
                 loss = Value::add(loss, b);
@@ -66,23 +86,39 @@ namespace microgradpp::loss{
     };
 
 
-    class MeanSquaredErrorFor1DPixels : public AbstractLoss<Tensor2D>{
+    /**
+     * @brief Sum of squared differences over the first row of single-row tensors.
+     * @tparam S The scalar type of the tensors (see BasicValue).
+     */
+    template<class S>
+    class BasicMeanSquaredErrorFor1DPixels : public AbstractLoss<BasicTensor2D<S>>{
     public:
-        MeanSquaredErrorFor1DPixels () = default;
+        using Value = BasicValue<S>;
+        using ValueRef = BasicValueRef<S>;
+        using Tensor2D = BasicTensor2D<S>;
+
+        BasicMeanSquaredErrorFor1DPixels () = default;
 
         /**
          * @brief Computes the mean squared error loss for 1D pixel values.
          * 
          * @param groundTruth The true pixel values.
          * @param prediction The predicted pixel values.
-         * @return ValuePtr The computed mean squared error loss.
+         * @return ValueRef The computed mean squared error loss.
          */
-        ValuePtr operator()(const Tensor2D& groundTruth, const Tensor2D& prediction) override{
+        ValueRef operator()(const Tensor2D& groundTruth, const Tensor2D& prediction) override{
             // Calculate loss
-            auto loss = Value::create(0.0f);
+            auto loss = Value::createTransient(0);
             const size_t  maxSize = prediction[0].size();
             assert(groundTruth.size() == prediction.size());
             for (size_t i = 0; i < maxSize; ++i) {
+#ifdef MICROGRADPP_FUSED_EXPRESSIONS
+                if constexpr (std::is_same_v<S, float>) { // Fused kernels compute in float
+                    const auto c = expr::var(groundTruth.at(0,i)) - expr::var(prediction.at(0,i));
+                    loss = expr::fuse(expr::var(loss) + c * c);
+                    continue;
+                }
+#endif
                 auto c = Value::subtract(groundTruth.at(0,i) , prediction.at(0,i));
                 auto b = Value::multiply(c, c);
                 loss = Value::add(loss, b);
@@ -90,4 +126,15 @@ namespace microgradpp::loss{
             return loss;
         }
     };
+
+    using MeanSquaredError = BasicMeanSquaredError<float>;
+    using MeanSquaredErrorFor1DPixels = BasicMeanSquaredErrorFor1DPixels<float>;
+
+#ifdef MICROGRADPP_EXTERN_TEMPLATES
+    // Instantiated once in src/ScalarInstantiations.cpp
+    extern template class BasicMeanSquaredError<double>;
+    extern template class BasicMeanSquaredError<bfloat16>;
+    extern template class BasicMeanSquaredErrorFor1DPixels<double>;
+    extern template class BasicMeanSquaredErrorFor1DPixels<bfloat16>;
+#endif
 }
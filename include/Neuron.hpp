@@ -49,6 +49,7 @@
 #include <numeric> // For std::transform_reduce
 
 #include <future>
+#include <type_traits>
 
 namespace microgradpp {
 
@@ -61,24 +62,56 @@ namespace microgradpp {
  *
  * @return A random float between -1 and 1.
  */
-    float getRandomFloat() {
+    inline float getRandomFloat() {
         static std::random_device rd;
         static std::mt19937 gen(rd());
         static std::uniform_real_distribution<> dis(-1, 1);
         return static_cast<float>(dis(gen));
     }
 
+/**
+ * @brief Generates a random number between -1 and 1 of type S.
+ *
+ * Draws from the same generator as getRandomFloat(), so float models are initialised
+ * exactly as before.
+ *
+ * @tparam S The type to return.
+ * @return A random number between -1 and 1.
+ */
+    template<class S>
+    S getRandom() {
+        if constexpr (std::is_same_v<S, float>) {
+            return getRandomFloat();
+        } else {
+            static std::random_device rd;
+            static std::mt19937 gen(rd());
+            static std::uniform_real_distribution<double> dis(-1, 1);
+            return static_cast<S>(dis(gen));
+        }
+    }
+
 /**
  * @brief Represents a single neuron in a neural network.
  *
  * The Neuron class contains weights and a bias that are used for calculating
  * the output of the neuron given an input tensor. It also provides methods
  * for parameter management, gradient resetting, and output computation.
+ *
+ * @tparam S The scalar type of the parameters (see BasicValue).
  */
-    class Neuron {
+    template<class S>
+    class BasicNeuron {
+    public:
+        using Value = BasicValue<S>;                ///< Node type of the parameters.
+        using ValueRef = BasicValueRef<S>;          ///< Handle to a node.
+        using ValuePtr = BasicValuePtr<S>;          ///< Owning pointer to a node.
+        using Tensor1D = BasicTensor1D<S>;          ///< Vector of nodes.
+        using TensorView = BasicTensorView<S>;      ///< Non-owning view of nodes.
+        using Compute = typename Value::Compute;    ///< Type the parameters compute in.
+
     private:
         Tensor1D weights;      ///< Weights of the neuron.
-        ValuePtr bias = Value::create(0.0f); ///< Bias of the neuron.
+        ValuePtr bias = Value::create(0); ///< Bias of the neuron.
 
     public:
         /**
@@ -88,9 +121,9 @@ namespace microgradpp {
          *
          * @param nin The number of input connections to the neuron.
          */
-        Neuron(size_t nin) {
+        BasicNeuron(size_t nin) {
             for (size_t idx = 0; idx < nin; ++idx) {
-                weights.emplace_back(Value::create(getRandomFloat()));
+                weights.emplace_back(Value::create(getRandom<Compute>()));
             }
         }
 
@@ -103,9 +136,9 @@ namespace microgradpp {
          * @param nin The number of input connections to the neuron.
          * @param val A float value (currently unused).
          */
-        Neuron(size_t nin, float val) {
+        BasicNeuron(size_t nin, float val) {
             for (size_t idx = 0; idx < nin; ++idx) {
-                weights.emplace_back(Value::create(getRandomFloat()));
+                weights.emplace_back(Value::create(getRandom<Compute>()));
             }
         }
 
@@ -126,31 +159,22 @@ namespace microgradpp {
          * @brief Computes the output of the neuron for a given input.
          *
          * This operator overload calculates the dot product of the neuron's
-         * weights and the input tensor, adds the bias, and returns the result.
+         * weights and the input tensor, adds the bias, and returns the result
+         * as a single fused graph node (see Value::dot).
          * If the input tensor size does not match the weights size, an exception
          * is thrown.
          *
-         * @param x The input tensor (1D) to the neuron.
-         * @return A pointer to the resulting Value after computation.
+         * @param x The input tensor (1D), or a view of one, to the neuron.
+         * @return A handle to the resulting Value after computation.
          * @throws std::invalid_argument If the input size does not match the
          *         weights size.
          */
-        ValuePtr operator()(const Tensor1D& x) {
+        ValueRef operator()(TensorView x) {
             if (x.size() != weights.size()) {
                 throw std::invalid_argument("Error in micrograd::Neuron -> Vectors must be of the same length");
             }
 
-            ValuePtr sum = Value::create(0.0);
-
-            for (size_t idx = 0; idx < weights.size(); ++idx) {
-                ValuePtr intermediateVal = Value::multiply(x[idx], weights[idx]);
-                sum = Value::add(sum, intermediateVal);
-            }
-
-            // Add bias
-            sum = Value::add(sum, bias);
-
-            return sum;
+            return Value::dot(weights, x, bias);
         }
 
         /**
@@ -172,6 +196,24 @@ namespace microgradpp {
             return out;
         }
 
+        /**
+         * @brief Returns the weights of the neuron.
+         * @return The weights, one per input.
+         */
+        __MICROGRADPP_NO_DISCARD__
+        const Tensor1D& getWeights() const {
+            return weights;
+        }
+
+        /**
+         * @brief Returns the bias of the neuron.
+         * @return A handle to the bias.
+         */
+        __MICROGRADPP_NO_DISCARD__
+        ValueRef getBias() const {
+            return bias;
+        }
+
         /**
          * @brief Prints the parameters of the neuron.
          *
@@ -181,9 +223,9 @@ namespace microgradpp {
         void printParameters() const {
             printf("Number of Parameters: %zu\n", weights.size() + 1);
             for (const auto& param : weights) {
-                printf("%f, %f\n", param->data, param->grad);
+                printf("%f, %f\n", static_cast<double>(param->data), static_cast<double>(param->grad));
             }
-            printf("%f, %f\n", bias->data, bias->grad);
+            printf("%f, %f\n", static_cast<double>(bias->data), static_cast<double>(bias->grad));
             printf("\n");
         }
 
@@ -201,6 +243,14 @@ namespace microgradpp {
         }
     };
 
+    using Neuron = BasicNeuron<float>;
+
+#ifdef MICROGRADPP_EXTERN_TEMPLATES
+    // Instantiated once in src/ScalarInstantiations.cpp
+    extern template class BasicNeuron<double>;
+    extern template class BasicNeuron<bfloat16>;
+#endif
+
 } // namespace microgradpp
 
 #endif //MICROGRADPP_NEURON_HPP
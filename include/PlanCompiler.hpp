@@ -0,0 +1,546 @@
+/**
+ *  @file PlanCompiler.hpp
+ *  @brief Lowers a captured tape to C++ source and loads the compiled code as a shared object.
+ *
+ *  This file is part of the microgradpp project, a lightweight C++ library for neural
+ *  network training and inference.
+ *
+ *  @section License
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  @section Author
+ *  Gautam Sharma
+ *  Email: gautamsharma2813@gmail.com
+ *  Date: October 16, 2026
+ *
+ *  @details
+ *  The generated code has one statement per record: the forward pass in recording order and
+ *  the backward rules in reverse, with every node slot and constant fixed at compile time.
+ *  Expressions are written exactly as `BasicAutograd` evaluates them and the object is built
+ *  with `-ffp-contract=off`, so native and interpreted replays give the same bits.
+ *
+ *  The compiler is `$CXX` (or `c++`), run directly rather than through a shell. Objects are
+ *  cached by a hash of their source in `$MICROGRADPP_CACHE_DIR`, or in the per-user
+ *  `$XDG_CACHE_HOME/microgradpp` (`~/.cache/microgradpp`), so a graph already seen by an
+ *  earlier run is loaded without compiling. The cache directory is created with mode 0700,
+ *  and a directory or object not owned by the current user, or writable by others, is never
+ *  loaded from. Loading fails quietly when no compiler or no dynamic loader is available;
+ *  callers keep using the interpreter.
+ */
+
+#pragma once
+
+// Standard libraries
+#include <algorithm>
+#include <cmath>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <pwd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define MICROGRADPP_HAS_DLOPEN
+#endif
+
+// microgradpp headers
+#include "Value.hpp"
+#include "TypeDefs.hpp"
+
+namespace microgradpp {
+
+    static_assert(offsetof(Value, data) == 0 && offsetof(Value, grad) == sizeof(float),
+                  "generated code addresses Value as { float data; float grad; }");
+
+    /**
+     * @class NativePlan
+     * @brief A compiled plan loaded from a shared object. Closes the object on destruction.
+     *
+     * Both entry points take the table of node addresses built by `PlanCompiler::generate()`.
+     */
+    class NativePlan {
+    private:
+        using Function = void (*)(void* const*);
+
+        void* _handle = nullptr;        ///< Handle returned by dlopen
+        Function _forward = nullptr;    ///< Forward pass of the plan
+        Function _backward = nullptr;   ///< Backward rules of the plan
+
+        friend class PlanCompiler;
+
+    public:
+        NativePlan() = default;
+        NativePlan(const NativePlan&) = delete;
+        NativePlan& operator=(const NativePlan&) = delete;
+
+        NativePlan(NativePlan&& other) noexcept
+                : _handle(std::exchange(other._handle, nullptr)),
+                  _forward(std::exchange(other._forward, nullptr)),
+                  _backward(std::exchange(other._backward, nullptr)) {}
+
+        NativePlan& operator=(NativePlan&& other) noexcept {
+            if (this != &other) {
+                close();
+                _handle = std::exchange(other._handle, nullptr);
+                _forward = std::exchange(other._forward, nullptr);
+                _backward = std::exchange(other._backward, nullptr);
+            }
+            return *this;
+        }
+
+        ~NativePlan() {
+            close();
+        }
+
+        /**
+         * @brief Returns true if a compiled plan is loaded.
+         */
+        explicit operator bool() const {
+            return _handle != nullptr;
+        }
+
+        /**
+         * @brief Runs the compiled forward pass.
+         * @param nodes Node addresses, indexed as in the generated source.
+         */
+        void forward(void* const* nodes) const {
+            _forward(nodes);
+        }
+
+        /**
+         * @brief Runs the compiled backward rules.
+         * @param nodes Node addresses, indexed as in the generated source.
+         */
+        void backward(void* const* nodes) const {
+            _backward(nodes);
+        }
+
+    private:
+        void close() noexcept {
+#ifdef MICROGRADPP_HAS_DLOPEN
+            if (_handle) {
+                dlclose(_handle);
+            }
+#endif
+            _handle = nullptr;
+            _forward = nullptr;
+            _backward = nullptr;
+        }
+    };
+
+    /**
+     * @class PlanCompiler
+     * @brief Generates, builds and loads the native code of a tape.
+     */
+    class PlanCompiler {
+    public:
+        /**
+         * @brief Flags passed to the compiler. Part of the cache key.
+         */
+        static constexpr const char* FLAGS = "-std=c++17 -O2 -ffp-contract=off -fPIC -shared";
+
+        /**
+         * @brief Writes the C++ source of `entries`.
+         *
+         * @param entries The records, in the order they were recorded.
+         * @param args The operand buffer the n-ary records refer to.
+         * @param nodes Receives the tape index of every node the source refers to; slot `i` of
+         *        the address table passed to NativePlan must point to `nodes[i]`.
+         * @return The source, or an empty string if a record cannot be lowered (checkpoints,
+         *         fused expressions, dense tensor operations).
+         */
+        static std::string generate(const std::vector<TapeEntry>& entries, const std::vector<uint32_t>& args,
+                                    std::vector<uint32_t>& nodes) {
+            nodes.clear();
+            std::unordered_map<uint32_t, uint32_t> slots; // tape index -> position in `nodes`
+            auto slot = [&](uint32_t index) {
+                const auto [it, inserted] = slots.try_emplace(index, static_cast<uint32_t>(nodes.size()));
+                if (inserted) {
+                    nodes.push_back(index);
+                }
+                return std::to_string(it->second);
+            };
+            auto local = [&](uint32_t index) {
+                return "n[" + slot(index) + "]";
+            };
+
+            std::vector<std::string> forward;  // one statement per record, in recording order
+            std::vector<std::string> backward;
+            std::string tables;
+            for (const auto& entry : entries) {
+                if (entry.op == OpCode::CHECKPOINT || entry.op == OpCode::FUSED || entry.op == OpCode::TENSOR) {
+                    nodes.clear();
+                    return {};
+                }
+                if (entry.op == OpCode::RELU_MASK) {
+                    // Lowered to one RELU per element; the compiled code has no mask to refresh
+                    const uint32_t* inputs = args.data() + entry.lhs;
+                    for (uint32_t idx = 0; idx < entry.rhs; ++idx) {
+                        const std::string x = local(inputs[idx]);
+                        const std::string y = local(inputs[entry.rhs + idx]);
+                        forward.push_back("    " + y + "->data = std::max(0.0f, " + x + "->data);\n");
+                        backward.push_back("    { const float g = " + y + "->grad; " + x + "->grad += static_cast<float>("
+                                           + y + "->data > 0) * g; }\n");
+                    }
+                    continue;
+                }
+                const std::string out = local(entry.out);
+                if (entry.op == OpCode::DOT || entry.op == OpCode::SUM) {
+                    // Operands go to a table in the interpreter's layout; the kernels walk it in the same order
+                    const std::string table = "t" + std::to_string(forward.size());
+                    const std::string kernel = entry.op == OpCode::DOT ? "dot" : "sum";
+                    const uint32_t count = BasicAutograd<Value>::operandCount(entry);
+                    tables += "static const unsigned " + table + "[] = {";
+                    for (uint32_t idx = 0; idx < count; ++idx) {
+                        tables += (idx ? "," : "") + slot(args[entry.lhs + idx]);
+                    }
+                    tables += "};\n";
+                    const std::string call = "(n, " + out + ", " + table + ", " + std::to_string(entry.rhs) + ");\n";
+                    forward.push_back("    " + kernel + call);
+                    backward.push_back("    " + kernel + "_backward" + call);
+                    continue;
+                }
+
+                const std::string lhs = local(entry.lhs);
+                const std::string rhs = entry.rhs == BasicAutograd<Value>::NONE ? std::string() : local(entry.rhs);
+                const std::string aux = literal(entry.aux);
+                std::string fwd = "    { const float x = " + lhs + "->data; " + out + "->data = ";
+                std::string bwd = "    { const float g = " + out + "->grad;";
+                switch (entry.op) {
+                    case OpCode::ADD:
+                        fwd += "x + " + rhs + "->data;";
+                        bwd += " " + lhs + "->grad += g; " + rhs + "->grad += g;";
+                        break;
+                    case OpCode::SUBTRACT:
+                        fwd += "x - " + rhs + "->data;";
+                        bwd += " " + lhs + "->grad += g; " + rhs + "->grad += -g;";
+                        break;
+                    case OpCode::MULTIPLY:
+                        fwd += "x * " + rhs + "->data;";
+                        bwd += " " + lhs + "->grad += " + rhs + "->data * g; "
+                               + rhs + "->grad += " + lhs + "->data * g;";
+                        break;
+                    case OpCode::ADD_CONST:
+                        fwd += "x + " + aux + ";";
+                        bwd += " " + lhs + "->grad += g;";
+                        break;
+                    case OpCode::MUL_CONST:
+                        fwd += "x * " + aux + ";";
+                        bwd += " " + lhs + "->grad += " + aux + " * g;";
+                        break;
+                    case OpCode::POW:
+                        fwd += "std::pow(x, " + aux + ");";
+                        bwd += " " + lhs + "->grad += " + aux + " * std::pow(" + lhs + "->data, "
+                               + aux + " - 1) * g;";
+                        break;
+                    case OpCode::TANH:
+                        fwd += "(std::exp(2 * x) - 1) / (std::exp(2 * x) + 1);";
+                        bwd += " const float t = " + out + "->data; " + lhs + "->grad += (1 - t * t) * g;";
+                        break;
+                    case OpCode::RELU:
+                        fwd += "std::max(0.0f, x);";
+                        bwd += " " + lhs + "->grad += static_cast<float>(" + out + "->data > 0) * g;";
+                        break;
+                    case OpCode::SIGMOID:
+                        fwd += "std::exp(x) / (1 + std::exp(x));";
+                        bwd += " const float t = " + out + "->data; " + lhs + "->grad += t * (1 - t) * g;";
+                        break;
+                    case OpCode::DOT:
+                    case OpCode::SUM:
+                    case OpCode::FUSED:
+                    case OpCode::RELU_MASK:
+                    case OpCode::CHECKPOINT:
+                    case OpCode::TENSOR:
+                    case OpCode::LEAF:
+                        fwd += "x;";
+                        break;
+                }
+                fwd += " }\n";
+                forward.push_back(std::move(fwd));
+                backward.push_back(bwd + " }\n");
+            }
+
+            std::reverse(backward.begin(), backward.end());
+
+            return "// Generated by microgradpp::PlanCompiler\n"
+                   "#include <algorithm>\n"
+                   "#include <cmath>\n\n"
+                   "namespace {\n"
+                   "    struct Node { float data; float grad; };\n\n"
+                   "    inline void dot(Node* const* n, Node* out, const unsigned* t, unsigned k) {\n"
+                   "        float s = 0.0f;\n"
+                   "        for (unsigned i = 0; i < k; ++i) s += n[t[k + i]]->data * n[t[i]]->data;\n"
+                   "        out->data = s + n[t[2 * k]]->data;\n"
+                   "    }\n\n"
+                   "    inline void dot_backward(Node* const* n, Node* out, const unsigned* t, unsigned k) {\n"
+                   "        const float g = out->grad;\n"
+                   "        for (unsigned i = 0; i < k; ++i) {\n"
+                   "            Node* w = n[t[i]];\n"
+                   "            Node* x = n[t[k + i]];\n"
+                   "            w->grad += x->data * g;\n"
+                   "            x->grad += w->data * g;\n"
+                   "        }\n"
+                   "        n[t[2 * k]]->grad += g;\n"
+                   "    }\n\n"
+                   "    inline void sum(Node* const* n, Node* out, const unsigned* t, unsigned k) {\n"
+                   "        float s = 0.0f;\n"
+                   "        for (unsigned i = 0; i < k; ++i) s += n[t[i]]->data;\n"
+                   "        out->data = s;\n"
+                   "    }\n\n"
+                   "    inline void sum_backward(Node* const* n, Node* out, const unsigned* t, unsigned k) {\n"
+                   "        const float g = out->grad;\n"
+                   "        for (unsigned i = 0; i < k; ++i) n[t[i]]->grad += g;\n"
+                   "    }\n"
+                   "}\n\n"
+                   + tables + "\n"
+                   + function("microgradpp_forward", forward)
+                   + function("microgradpp_backward", backward);
+        }
+
+        /**
+         * @brief Loads the object built from `source`, compiling it first if it is not cached.
+         * @param source Output of generate().
+         * @return The loaded plan, or an empty one if the object could not be built or loaded.
+         */
+        static NativePlan load(const std::string& source) {
+            NativePlan plan;
+#ifdef MICROGRADPP_HAS_DLOPEN
+            if (source.empty()) {
+                return plan;
+            }
+            std::error_code error;
+            const std::filesystem::path directory = cacheDirectory();
+            if (directory.empty()) {
+                return plan;
+            }
+            if (directory.has_parent_path()) {
+                std::filesystem::create_directories(directory.parent_path(), error);
+            }
+            if (mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST) {
+                return plan;
+            }
+            if (!isPrivate(directory, S_IFDIR)) {
+                return plan;
+            }
+
+            const std::string compiler = std::getenv("CXX") ? std::getenv("CXX") : "c++";
+            char key[17];
+            std::snprintf(key, sizeof(key), "%016llx",
+                          static_cast<unsigned long long>(hash(compiler + '\n' + FLAGS + '\n' + source)));
+            const std::filesystem::path object = directory / ("plan_" + std::string(key) + ".so");
+
+            if (!std::filesystem::exists(object, error)) {
+                // Build under a private name and rename, so concurrent builders never load a partial object
+                const std::string stem = "plan_" + std::string(key) + "." + std::to_string(getpid());
+                const std::filesystem::path file = directory / (stem + ".cpp");
+                const std::filesystem::path temporary = directory / (stem + ".so");
+                {
+                    std::ofstream stream(file);
+                    stream << source;
+                    if (!stream) {
+                        return plan;
+                    }
+                }
+                const bool built = build(compiler, temporary, file);
+                std::filesystem::remove(file, error);
+                if (!built) {
+                    std::filesystem::remove(temporary, error);
+                    return plan;
+                }
+                std::filesystem::rename(temporary, object, error);
+                if (error) {
+                    std::filesystem::remove(temporary, error);
+                    return plan;
+                }
+            }
+
+            if (!isPrivate(object, S_IFREG)) {
+                return plan;
+            }
+            plan._handle = dlopen(object.c_str(), RTLD_NOW | RTLD_LOCAL);
+            if (!plan._handle) {
+                return plan;
+            }
+            plan._forward = reinterpret_cast<NativePlan::Function>(dlsym(plan._handle, "microgradpp_forward"));
+            plan._backward = reinterpret_cast<NativePlan::Function>(dlsym(plan._handle, "microgradpp_backward"));
+            if (!plan._forward || !plan._backward) {
+                plan.close();
+            }
+#endif
+            return plan;
+        }
+
+        /**
+         * @brief Returns the directory compiled plans are cached in.
+         * @return `$MICROGRADPP_CACHE_DIR`, else `microgradpp` under the user's cache directory,
+         *         or an empty path when the user has no home directory.
+         */
+        static std::filesystem::path cacheDirectory() {
+            if (const char* directory = std::getenv("MICROGRADPP_CACHE_DIR")) {
+                return directory;
+            }
+            if (const char* cache = std::getenv("XDG_CACHE_HOME"); cache && *cache) {
+                return std::filesystem::path(cache) / "microgradpp";
+            }
+            const char* home = std::getenv("HOME");
+#ifdef MICROGRADPP_HAS_DLOPEN
+            if (!home || !*home) {
+                const passwd* user = getpwuid(geteuid());
+                home = user ? user->pw_dir : nullptr;
+            }
+#endif
+            if (!home || !*home) {
+                return {};
+            }
+            return std::filesystem::path(home) / ".cache" / "microgradpp";
+        }
+
+        /**
+         * @brief 64-bit FNV-1a hash, used as the cache key.
+         */
+        static uint64_t hash(const std::string& text) {
+            uint64_t value = 14695981039346656037ull;
+            for (const unsigned char c : text) {
+                value = (value ^ c) * 1099511628211ull;
+            }
+            return value;
+        }
+
+    private:
+#ifdef MICROGRADPP_HAS_DLOPEN
+        /**
+         * @brief Checks that `path` is of the given file type (not a symbolic link), owned by
+         * the effective user and not writable by group or others.
+         * @param path The cache directory or a cached object.
+         * @param type S_IFDIR or S_IFREG.
+         */
+        static bool isPrivate(const std::filesystem::path& path, mode_t type) {
+            struct stat status {};
+            if (lstat(path.c_str(), &status) != 0) {
+                return false;
+            }
+            return (status.st_mode & S_IFMT) == type && status.st_uid == geteuid()
+                   && (status.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+        }
+
+        /**
+         * @brief Compiles `source` into the shared object `object`.
+         *
+         * The compiler is executed directly with an argument vector, so neither `$CXX` nor the
+         * paths are interpreted by a shell. `$CXX` is split at spaces to allow launchers such
+         * as `ccache c++`.
+         *
+         * @return True if the compiler exited successfully.
+         */
+        static bool build(const std::string& compiler, const std::filesystem::path& object,
+                          const std::filesystem::path& source) {
+            std::vector<std::string> arguments;
+            for (const std::string& words : {compiler, std::string(FLAGS)}) {
+                size_t begin = words.find_first_not_of(' ');
+                while (begin != std::string::npos) {
+                    const size_t end = words.find(' ', begin);
+                    arguments.push_back(words.substr(begin, end - begin));
+                    begin = words.find_first_not_of(' ', end);
+                }
+            }
+            if (arguments.empty()) {
+                return false;
+            }
+            arguments.insert(arguments.end(), {"-o", object.string(), source.string()});
+            std::vector<char*> argv;
+            for (auto& argument : arguments) {
+                argv.push_back(argument.data());
+            }
+            argv.push_back(nullptr);
+
+            const pid_t child = fork();
+            if (child < 0) {
+                return false;
+            }
+            if (child == 0) {
+                const int null = open("/dev/null", O_WRONLY);
+                if (null >= 0) {
+                    dup2(null, STDOUT_FILENO);
+                    dup2(null, STDERR_FILENO);
+                }
+                execvp(argv[0], argv.data());
+                _exit(127);
+            }
+            int status = 0;
+            while (waitpid(child, &status, 0) < 0) {
+                if (errno != EINTR) {
+                    return false;
+                }
+            }
+            return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+#endif
+
+        /**
+         * @brief Emits `statements` as an exported function.
+         *
+         * Statements are grouped into non-inlined helpers of CHUNK statements, which keeps the
+         * compile time linear in the size of the graph (optimizers scale badly with function size).
+         */
+        static std::string function(const std::string& name, const std::vector<std::string>& statements) {
+            constexpr size_t CHUNK = 256;
+            std::string helpers;
+            std::string calls;
+            for (size_t begin = 0; begin < statements.size(); begin += CHUNK) {
+                const std::string helper = name + "_" + std::to_string(begin / CHUNK);
+                helpers += "static __attribute__((noinline)) void " + helper + "(Node* const* n) {\n";
+                for (size_t idx = begin; idx < std::min(begin + CHUNK, statements.size()); ++idx) {
+                    helpers += statements[idx];
+                }
+                helpers += "}\n\n";
+                calls += "    " + helper + "(n);\n";
+            }
+            return helpers
+                   + "extern \"C\" void " + name + "(void* const* p) {\n"
+                   "    Node* const* n = reinterpret_cast<Node* const*>(p);\n"
+                   + calls
+                   + "}\n\n";
+        }
+
+        /**
+         * @brief Spells `value` as a float literal that reads back to the same bits.
+         */
+        static std::string literal(float value) {
+            if (std::isnan(value)) {
+                return "__builtin_nanf(\"\")";
+            }
+            if (std::isinf(value)) {
+                return value > 0 ? "__builtin_inff()" : "(-__builtin_inff())";
+            }
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%af", static_cast<double>(value));
+            return "(" + std::string(buffer) + ")";
+        }
+    };
+
+} // namespace microgradpp
@@ -0,0 +1,213 @@
+/**
+ *  @file Scalar.hpp
+ *  @brief Defines the scalar types nodes can store and the type their arithmetic runs in.
+ *
+ *  This file is part of the microgradpp project, a lightweight C++ library for neural
+ *  network training and inference.
+ *
+ *  @section License
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  @section Author
+ *  Gautam Sharma
+ *  Email: gautamsharma2813@gmail.com
+ *  Date: October 16, 2026
+ *
+ *  @details
+ *  `BasicValue<S>` stores its data and gradient as `S` and computes in
+ *  `ScalarTraits<S>::Compute`. For float and double both are the same type. `bfloat16` is a
+ *  storage-only type: values are widened to float for every operation, sums are accumulated
+ *  in float, and only the stored results are rounded back. This halves the memory of the
+ *  nodes of memory-bound models.
+ *
+ *  `Dual<T>` carries a value and its derivative along one direction (the tangent). Nodes
+ *  storing duals compute forward-mode derivatives as they compute values, so their tape
+ *  records nothing (see ForwardMode.hpp).
+ */
+
+#pragma once
+
+// Standard libraries
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <type_traits>
+
+namespace microgradpp {
+
+    /**
+     * @brief 16-bit brain floating point number: the upper half of an IEEE float.
+     *
+     * Converts implicitly to and from float, so it can be used wherever a float is read or
+     * written. Conversion from float rounds to nearest even.
+     */
+    struct bfloat16 {
+        uint16_t bits = 0; ///< Sign, 8 exponent bits and 7 mantissa bits
+
+        bfloat16() = default;
+
+        bfloat16(float value) {
+            uint32_t word;
+            std::memcpy(&word, &value, sizeof(word));
+            if (std::isnan(value)) {
+                bits = static_cast<uint16_t>((word >> 16) | 0x40); // Keep it a quiet NaN
+                return;
+            }
+            word += 0x7FFF + ((word >> 16) & 1);
+            bits = static_cast<uint16_t>(word >> 16);
+        }
+
+        operator float() const {
+            const uint32_t word = static_cast<uint32_t>(bits) << 16;
+            float value;
+            std::memcpy(&value, &word, sizeof(value));
+            return value;
+        }
+
+        bfloat16& operator+=(float value) {
+            return *this = static_cast<float>(*this) + value;
+        }
+
+        bfloat16& operator-=(float value) {
+            return *this = static_cast<float>(*this) - value;
+        }
+
+        bfloat16& operator*=(float value) {
+            return *this = static_cast<float>(*this) * value;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, bfloat16 value) {
+            return os << static_cast<float>(value);
+        }
+    };
+
+    static_assert(sizeof(bfloat16) == 2, "bfloat16 is expected to be 2 bytes");
+
+    /**
+     * @brief Dual number `value + tangent * e` with `e * e = 0`.
+     *
+     * Every operation propagates the tangent by the chain rule, so after evaluating a
+     * function on inputs seeded with tangents v, the tangent of the result is the
+     * directional derivative J v. Comparisons look at the value only.
+     *
+     * @tparam T The type of the value and tangent (float or double).
+     */
+    template<class T>
+    struct Dual {
+        T value = 0;   ///< The value
+        T tangent = 0; ///< Its derivative along the seeded direction
+
+        Dual() = default;
+
+        Dual(T value, T tangent = 0) : value(value), tangent(tangent) {}
+
+        template<class U, class = std::enable_if_t<std::is_arithmetic_v<U>>>
+        explicit operator U() const {
+            return static_cast<U>(value);
+        }
+
+        Dual& operator+=(const Dual& other) {
+            return *this = *this + other;
+        }
+
+        Dual& operator-=(const Dual& other) {
+            return *this = *this - other;
+        }
+
+        Dual& operator*=(const Dual& other) {
+            return *this = *this * other;
+        }
+
+        friend Dual operator+(const Dual& lhs, const Dual& rhs) {
+            return {lhs.value + rhs.value, lhs.tangent + rhs.tangent};
+        }
+
+        friend Dual operator-(const Dual& lhs, const Dual& rhs) {
+            return {lhs.value - rhs.value, lhs.tangent - rhs.tangent};
+        }
+
+        friend Dual operator-(const Dual& arg) {
+            return {-arg.value, -arg.tangent};
+        }
+
+        friend Dual operator*(const Dual& lhs, const Dual& rhs) {
+            return {lhs.value * rhs.value, lhs.tangent * rhs.value + lhs.value * rhs.tangent};
+        }
+
+        friend Dual operator/(const Dual& lhs, const Dual& rhs) {
+            return {lhs.value / rhs.value, (lhs.tangent * rhs.value - lhs.value * rhs.tangent) / (rhs.value * rhs.value)};
+        }
+
+        friend bool operator<(const Dual& lhs, const Dual& rhs) { return lhs.value < rhs.value; }
+        friend bool operator>(const Dual& lhs, const Dual& rhs) { return lhs.value > rhs.value; }
+        friend bool operator<=(const Dual& lhs, const Dual& rhs) { return lhs.value <= rhs.value; }
+        friend bool operator>=(const Dual& lhs, const Dual& rhs) { return lhs.value >= rhs.value; }
+        friend bool operator==(const Dual& lhs, const Dual& rhs) { return lhs.value == rhs.value; }
+        friend bool operator!=(const Dual& lhs, const Dual& rhs) { return lhs.value != rhs.value; }
+
+        friend Dual exp(const Dual& arg) {
+            const T value = std::exp(arg.value);
+            return {value, value * arg.tangent};
+        }
+
+        friend Dual log(const Dual& arg) {
+            return {std::log(arg.value), arg.tangent / arg.value};
+        }
+
+        /**
+         * @brief `base ^ exponent`. The log term is only formed when the exponent has a
+         * tangent, so constant exponents work for non-positive bases.
+         */
+        friend Dual pow(const Dual& base, const Dual& exponent) {
+            const T value = std::pow(base.value, exponent.value);
+            T tangent = exponent.value * std::pow(base.value, exponent.value - 1) * base.tangent;
+            if (exponent.tangent != 0) {
+                tangent += value * std::log(base.value) * exponent.tangent;
+            }
+            return {value, tangent};
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const Dual& arg) {
+            return os << arg.value << " + " << arg.tangent << "e";
+        }
+    };
+
+    /**
+     * @brief Arithmetic type of a storage scalar.
+     *
+     * `forwardMode` is true for scalars that carry their own derivatives; the tapes of
+     * such nodes never record operations.
+     *
+     * @tparam S The type nodes store their data and gradient as.
+     */
+    template<class S>
+    struct ScalarTraits {
+        using Compute = S;
+        static constexpr bool forwardMode = false;
+    };
+
+    template<>
+    struct ScalarTraits<bfloat16> {
+        using Compute = float;
+        static constexpr bool forwardMode = false;
+    };
+
+    template<class T>
+    struct ScalarTraits<Dual<T>> {
+        using Compute = Dual<T>;
+        static constexpr bool forwardMode = true;
+    };
+
+} // namespace microgradpp
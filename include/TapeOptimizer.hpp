@@ -0,0 +1,395 @@
+/**
+ *  @file TapeOptimizer.hpp
+ *  @brief Defines TapeOptimizer, a set of rewrite passes over recorded tape entries.
+ *
+ *  This file is part of the microgradpp project, a lightweight C++ library for neural
+ *  network training and inference.
+ *
+ *  @section License
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  @section Author
+ *  Gautam Sharma
+ *  Email: gautamsharma2813@gmail.com
+ *  Date: October 16, 2026
+ *
+ *  @details
+ *  A recorded tape is a straight-line program. Before it is replayed many times (see
+ *  GraphPlan) it pays to rewrite it once. The passes run in this order:
+ *   - simplify: operands are renamed through the aliases found so far; `x * 1`, `x + 0` and
+ *     `pow(x, 1)` become aliases of `x`, and a record identical to an earlier one becomes an
+ *     alias of its output (common subexpression elimination);
+ *   - eliminate: records whose output neither reaches a kept node nor feeds another live
+ *     record are dropped;
+ *   - fuse: trees of single-use additions become one n-ary SUM record, and single-use
+ *     products added into such a tree become a DOT record (a multiply + add is the one-term
+ *     case, i.e. an FMA).
+ *  Fusion sums the terms of a tree in one pass, which can round differently from the
+ *  original pairwise additions.
+ *
+ *  Only plain scalar records can be rewritten. Checkpointed segments and dense tensor
+ *  operations read nodes the optimizer cannot see, so a run over records that contain them
+ *  is rejected (GraphPlan never captures them).
+ */
+
+#pragma once
+
+// Standard libraries
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// microgradpp headers
+#include "Autograd.hpp"
+#include "TypeDefs.hpp"
+
+namespace microgradpp {
+
+    /**
+     * @brief What a TapeOptimizer run changed.
+     */
+    struct TapeOptimizerStats {
+        size_t simplified = 0; ///< Identity records (x * 1, x + 0, pow(x, 1)) removed
+        size_t merged = 0;     ///< Duplicate records removed by common subexpression elimination
+        size_t dead = 0;       ///< Records removed because nothing uses their output
+        size_t fused = 0;      ///< Records folded into SUM or DOT records
+    };
+
+    /**
+     * @class TapeOptimizer
+     * @brief Rewrites tape entries into a shorter program with the same kept values and gradients.
+     *
+     * The optimizer only sees the records it is given, so every node read from outside them
+     * (model outputs, the loss) must be listed as kept; kept nodes are never aliased away.
+     * Nodes whose records are removed are not freed; they are simply no longer computed.
+     */
+    class TapeOptimizer {
+    private:
+        std::unordered_set<uint32_t> _keep;               ///< Nodes that must stay computed
+        std::unordered_map<uint32_t, uint32_t> _alias;    ///< Removed output -> node holding its value
+        TapeOptimizerStats _stats;                        ///< Changes made by the last run
+
+    public:
+        /**
+         * @brief Creates an optimizer.
+         * @param keep Nodes read from outside the records (model outputs, the loss).
+         */
+        explicit TapeOptimizer(const std::vector<uint32_t>& keep) : _keep(keep.begin(), keep.end()) {}
+
+        /**
+         * @brief Optimizes records in place.
+         * @param entries The records, in recording order.
+         * @param operands The operand buffer the n-ary records refer to; rebuilt compactly.
+         * @return What was changed.
+         * @throws std::logic_error If a record is a checkpoint or a dense tensor operation;
+         *         the records are left unchanged.
+         */
+        TapeOptimizerStats run(std::vector<TapeEntry>& entries, std::vector<uint32_t>& operands) {
+            if (std::any_of(entries.begin(), entries.end(), opaque)) {
+                throw std::logic_error("Error in microgradpp::TapeOptimizer -> cannot optimize checkpoint or dense tensor records");
+            }
+            _alias.clear();
+            _stats = {};
+            simplify(entries, operands);
+            eliminate(entries, operands);
+            fuse(entries, operands);
+            return _stats;
+        }
+
+    private:
+        /**
+         * @brief Key identifying the value a scalar record computes.
+         */
+        struct Key {
+            OpCode op;
+            uint32_t lhs;
+            uint32_t rhs;
+            uint32_t aux;
+
+            bool operator==(const Key& other) const {
+                return op == other.op && lhs == other.lhs && rhs == other.rhs && aux == other.aux;
+            }
+        };
+
+        struct KeyHash {
+            size_t operator()(const Key& key) const {
+                size_t hash = static_cast<size_t>(key.op);
+                hash = hash * 0x9E3779B97F4A7C15ull + key.lhs;
+                hash = hash * 0x9E3779B97F4A7C15ull + key.rhs;
+                hash = hash * 0x9E3779B97F4A7C15ull + key.aux;
+                return hash;
+            }
+        };
+
+        bool kept(uint32_t index) const {
+            return _keep.count(index) != 0;
+        }
+
+        uint32_t resolve(uint32_t index) const {
+            auto it = _alias.find(index);
+            while (it != _alias.end()) {
+                index = it->second;
+                it = _alias.find(index);
+            }
+            return index;
+        }
+
+        static bool nary(const TapeEntry& entry) {
+            return Autograd::isNary(entry);
+        }
+
+        /**
+         * @brief Calls `visit` with every operand of a record.
+         */
+        template<class Visit>
+        static void forEachOperand(const TapeEntry& entry, const std::vector<uint32_t>& operands, Visit&& visit) {
+            if (nary(entry)) {
+                for (uint32_t idx = 0; idx < Autograd::operandCount(entry); ++idx) {
+                    visit(operands[entry.lhs + idx]);
+                }
+            } else {
+                visit(entry.lhs);
+                if (entry.rhs != Autograd::NONE) {
+                    visit(entry.rhs);
+                }
+            }
+        }
+
+        /**
+         * @brief True for records whose operands are kept outside the tape (checkpoints and
+         * dense tensor operations), which run() rejects.
+         */
+        static bool opaque(const TapeEntry& entry) {
+            return entry.op == OpCode::CHECKPOINT || entry.op == OpCode::TENSOR;
+        }
+
+        /**
+         * @brief Returns true if a record writes a node in `live`.
+         */
+        static bool produces(const TapeEntry& entry, const std::vector<uint32_t>& operands,
+                             const std::unordered_set<uint32_t>& live) {
+            if (entry.op == OpCode::RELU_MASK) {
+                const uint32_t* outputs = operands.data() + entry.lhs + entry.rhs;
+                return std::any_of(outputs, outputs + entry.rhs, [&live](uint32_t output) { return live.count(output) > 0; });
+            }
+            return live.count(entry.out) > 0;
+        }
+
+        /**
+         * @brief Renames operands, removes identity records and merges duplicate records.
+         */
+        void simplify(std::vector<TapeEntry>& entries, std::vector<uint32_t>& operands) {
+            std::unordered_map<Key, uint32_t, KeyHash> seen;
+            std::vector<TapeEntry> out;
+            out.reserve(entries.size());
+            for (TapeEntry entry : entries) {
+                if (nary(entry)) {
+                    for (uint32_t idx = 0; idx < Autograd::operandCount(entry); ++idx) {
+                        operands[entry.lhs + idx] = resolve(operands[entry.lhs + idx]);
+                    }
+                    out.push_back(entry);
+                    continue;
+                }
+                entry.lhs = resolve(entry.lhs);
+                if (entry.rhs != Autograd::NONE) {
+                    entry.rhs = resolve(entry.rhs);
+                }
+
+                const bool identity = (entry.op == OpCode::MUL_CONST && entry.aux == 1.0f)
+                                      || (entry.op == OpCode::ADD_CONST && entry.aux == 0.0f)
+                                      || (entry.op == OpCode::POW && entry.aux == 1.0f);
+                if (identity && !kept(entry.out)) {
+                    _alias[entry.out] = entry.lhs;
+                    ++_stats.simplified;
+                    continue;
+                }
+
+                Key key{entry.op, entry.lhs, entry.rhs, 0};
+                if ((entry.op == OpCode::ADD || entry.op == OpCode::MULTIPLY) && key.rhs < key.lhs) {
+                    std::swap(key.lhs, key.rhs); // Commutative
+                }
+                if (entry.op != OpCode::TANH && entry.op != OpCode::SIGMOID) {
+                    std::memcpy(&key.aux, &entry.aux, sizeof(float)); // Otherwise aux is a cached result
+                }
+                const auto found = seen.emplace(key, entry.out);
+                if (!found.second && !kept(entry.out)) {
+                    _alias[entry.out] = found.first->second;
+                    ++_stats.merged;
+                    continue;
+                }
+                out.push_back(entry);
+            }
+            entries.swap(out);
+        }
+
+        /**
+         * @brief Drops records whose output is neither kept nor used by a live record.
+         */
+        void eliminate(std::vector<TapeEntry>& entries, const std::vector<uint32_t>& operands) {
+            std::unordered_set<uint32_t> live(_keep.begin(), _keep.end());
+            std::vector<bool> alive(entries.size(), false);
+            for (size_t pos = entries.size(); pos-- > 0;) {
+                const TapeEntry& entry = entries[pos];
+                if (!produces(entry, operands, live)) {
+                    ++_stats.dead;
+                    continue;
+                }
+                alive[pos] = true;
+                forEachOperand(entry, operands, [&live](uint32_t operand) { live.insert(operand); });
+            }
+            size_t next = 0;
+            for (size_t pos = 0; pos < entries.size(); ++pos) {
+                if (alive[pos]) {
+                    entries[next++] = entries[pos];
+                }
+            }
+            entries.resize(next);
+        }
+
+        /**
+         * @brief Folds trees of single-use additions (and products added into them) into
+         * SUM and DOT records, and rebuilds the operand buffer.
+         */
+        void fuse(std::vector<TapeEntry>& entries, std::vector<uint32_t>& operands) {
+            std::unordered_map<uint32_t, uint32_t> uses;
+            std::unordered_map<uint32_t, size_t> producer;
+            for (size_t pos = 0; pos < entries.size(); ++pos) {
+                forEachOperand(entries[pos], operands, [&uses](uint32_t operand) { ++uses[operand]; });
+                producer[entries[pos].out] = pos;
+            }
+
+            // A single-use ADD or MULTIPLY whose only consumer is an ADD can be folded into it
+            std::vector<bool> folded(entries.size(), false);
+            auto foldable = [&](uint32_t operand, size_t& pos) {
+                const auto it = producer.find(operand);
+                if (it == producer.end() || uses[operand] != 1 || kept(operand)) {
+                    return false;
+                }
+                pos = it->second;
+                return entries[pos].op == OpCode::ADD || entries[pos].op == OpCode::MULTIPLY;
+            };
+            for (const TapeEntry& entry : entries) {
+                if (entry.op != OpCode::ADD) {
+                    continue;
+                }
+                size_t pos;
+                if (foldable(entry.lhs, pos)) {
+                    folded[pos] = true;
+                }
+                if (foldable(entry.rhs, pos)) {
+                    folded[pos] = true;
+                }
+            }
+
+            // Collect the terms of every tree rooted at an ADD that is not folded itself
+            struct Tree {
+                std::vector<uint32_t> plain;     ///< Terms added as they are
+                std::vector<size_t> products;    ///< Positions of folded MULTIPLY records
+            };
+            auto collect = [&](size_t root, size_t& members) {
+                Tree tree;
+                members = 0;
+                std::vector<uint32_t> stack{entries[root].rhs, entries[root].lhs};
+                while (!stack.empty()) {
+                    const uint32_t operand = stack.back();
+                    stack.pop_back();
+                    const auto it = producer.find(operand);
+                    if (it == producer.end() || !folded[it->second]) {
+                        tree.plain.push_back(operand);
+                        continue;
+                    }
+                    const TapeEntry& child = entries[it->second];
+                    if (child.op == OpCode::ADD) {
+                        ++members;
+                        stack.push_back(child.rhs);
+                        stack.push_back(child.lhs);
+                    } else {
+                        tree.products.push_back(it->second);
+                    }
+                }
+                return tree;
+            };
+            std::unordered_map<size_t, Tree> trees;
+            for (size_t pos = 0; pos < entries.size(); ++pos) {
+                if (entries[pos].op != OpCode::ADD || folded[pos]) {
+                    continue;
+                }
+                size_t members;
+                Tree tree = collect(pos, members);
+                // DOT takes exactly one plain term (the bias)
+                if (!tree.products.empty() && tree.plain.empty()) {
+                    folded[tree.products.front()] = false;
+                    tree.plain.push_back(entries[tree.products.front()].out);
+                    tree.products.erase(tree.products.begin());
+                }
+                if (tree.plain.size() > 1 && !tree.products.empty()) {
+                    // Too many plain terms for a DOT: compute the products separately
+                    for (const size_t product : tree.products) {
+                        folded[product] = false;
+                    }
+                    tree = collect(pos, members);
+                }
+                if (members == 0 && tree.products.empty()) {
+                    continue; // A lone ADD, nothing to fold
+                }
+                _stats.fused += members + tree.products.size();
+                trees.emplace(pos, std::move(tree));
+            }
+
+            std::vector<TapeEntry> out;
+            std::vector<uint32_t> args;
+            out.reserve(entries.size());
+            args.reserve(operands.size());
+            for (size_t pos = 0; pos < entries.size(); ++pos) {
+                TapeEntry entry = entries[pos];
+                if (folded[pos]) {
+                    continue;
+                }
+                const auto tree = trees.find(pos);
+                if (tree != trees.end()) {
+                    const auto offset = static_cast<uint32_t>(args.size());
+                    if (tree->second.products.empty()) {
+                        args.insert(args.end(), tree->second.plain.begin(), tree->second.plain.end());
+                        entry.op = OpCode::SUM;
+                        entry.rhs = static_cast<uint32_t>(tree->second.plain.size());
+                    } else {
+                        for (const size_t product : tree->second.products) {
+                            args.push_back(entries[product].lhs);
+                        }
+                        for (const size_t product : tree->second.products) {
+                            args.push_back(entries[product].rhs);
+                        }
+                        args.push_back(tree->second.plain.front());
+                        entry.op = OpCode::DOT;
+                        entry.rhs = static_cast<uint32_t>(tree->second.products.size());
+                    }
+                    entry.lhs = offset;
+                } else if (nary(entry)) {
+                    const auto offset = static_cast<uint32_t>(args.size());
+                    args.insert(args.end(), operands.begin() + entry.lhs,
+                                operands.begin() + entry.lhs + Autograd::operandSlots(entry));
+                    entry.lhs = offset;
+                }
+                out.push_back(entry);
+            }
+            entries.swap(out);
+            operands.swap(args);
+        }
+    };
+
+} // namespace microgradpp
@@ -34,10 +34,14 @@
 #define MICROGRADPP_TENSOR_HPP
 
 // Standard headers
+#include <cstddef>
 #include <initializer_list>
+#include <iterator>
 #include <vector>
 #include <memory>
 #include <iostream>
+#include <stdexcept>
+#include <type_traits>
 
 // mpp headers
 #include "Value.hpp"
@@ -48,7 +52,7 @@ namespace microgradpp {
      * @class BaseTensor
      * @brief A base class for tensor types providing common functionalities.
      *
-     * @tparam T The type of tensor (e.g., std::vector<ValuePtr>).
+     * @tparam T The type of tensor (e.g., std::vector<ValueRef>).
    */
     template<class T>
     class BaseTensor{
@@ -102,6 +106,15 @@ namespace microgradpp {
             return this->tensor.size();
         }
 
+        /**
+         * @brief Returns a pointer to the contiguous elements of the tensor.
+         * @return A pointer to the first element.
+         */
+        __MICROGRADPP_NO_DISCARD__
+        auto data() const {
+            return this->tensor.data();
+        }
+
         /**
          * @brief Clears the tensor.
          */
@@ -132,33 +145,358 @@ namespace microgradpp {
 
     };
 
+    // Internal Use
+    /**
+     * @brief Owners of the long-lived nodes of a Tensor1D, shared by its copies.
+     *
+     * @tparam R The handle type of the elements (e.g. ValueRef).
+     */
+    template<class R>
+    struct _TensorOwner {
+        std::shared_ptr<std::vector<typename R::Node::Ptr>> owned; ///< Values pushed as a ValuePtr.
+        std::shared_ptr<const typename R::Node::Block> block;      ///< Values created in bulk.
+    };
+
+    // Internal Use
+    /**
+     * @class _TensorView
+     * @brief A non-owning, strided view of ValueRef handles, e.g. one row of a Tensor2D.
+     *
+     * A view is a pointer, a length and a stride and is passed by value; making one never
+     * allocates or touches reference counts. It does not keep the viewed elements alive: it
+     * must not outlive the viewed tensor and, like an iterator, is invalidated when that
+     * tensor reallocates. A view of a Tensor1D also refers to the owners of its nodes, so a
+     * Tensor1D built from the view keeps them alive on its own. Tensor1D and
+     * std::vector<ValueRef> convert to views implicitly, so every function taking a view
+     * accepts them as well.
+     *
+     * @tparam R The handle type of the elements (e.g. ValueRef).
+     */
+    template<class R>
+    class _TensorView {
+    public:
+        using ValueRef = R;                          ///< Handle type of the elements.
+        using Value = typename ValueRef::Node;       ///< Node type of the elements.
+        using Compute = typename Value::Compute;     ///< Type the elements compute in.
+        using Owner = _TensorOwner<R>;               ///< Owners of the viewed nodes.
+
+        /**
+         * @brief Forward iterator stepping over the elements of a view.
+         */
+        class const_iterator {
+        private:
+            const ValueRef* _data;
+            size_t _stride;
+            size_t _idx;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ValueRef;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const ValueRef*;
+            using reference = const ValueRef&;
+
+            const_iterator(const ValueRef* data, size_t stride, size_t idx) : _data(data), _stride(stride), _idx(idx) {}
+
+            reference operator*() const { return _data[_idx * _stride]; }
+            pointer operator->() const { return _data + _idx * _stride; }
+
+            const_iterator& operator++() {
+                ++_idx;
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator previous = *this;
+                ++_idx;
+                return previous;
+            }
+
+            bool operator==(const const_iterator& other) const { return _idx == other._idx; }
+            bool operator!=(const const_iterator& other) const { return _idx != other._idx; }
+        };
+        using iterator = const_iterator; ///< Views are read-only.
+
+    private:
+        const ValueRef* _data = nullptr; ///< First element.
+        size_t _size = 0;                ///< Number of elements.
+        size_t _stride = 1;              ///< Distance between consecutive elements.
+        const Owner* _owner = nullptr;   ///< Owners of the viewed tensor, if it has any.
+
+        template<class C, class = void>
+        struct HasOwner : std::false_type {};
+
+        template<class C>
+        struct HasOwner<C, std::void_t<decltype(std::declval<const C&>().owner())>> : std::true_type {};
+
+    public:
+        _TensorView() = default;
+
+        /**
+         * @brief Views `size` elements starting at `data`, `stride` handles apart.
+         * @param data The first element.
+         * @param size The number of elements.
+         * @param stride The distance between consecutive elements.
+         * @param owner Owners of the viewed nodes, or nullptr.
+         */
+        _TensorView(const ValueRef* data, size_t size, size_t stride = 1, const Owner* owner = nullptr)
+                : _data(data), _size(size), _stride(stride), _owner(owner) {}
+
+        /**
+         * @brief Views all elements of a contiguous container of handles (e.g. Tensor1D).
+         * @param tensor The container; it must outlive the view.
+         */
+        template<class C, class = std::enable_if_t<
+                std::is_convertible_v<decltype(std::declval<const C&>().data()), const ValueRef*>>>
+        _TensorView(const C& tensor) : _data(tensor.data()), _size(tensor.size()) {
+            if constexpr (HasOwner<C>::value) {
+                _owner = &tensor.owner();
+            }
+        }
+
+        __MICROGRADPP_NO_DISCARD__ const_iterator begin() const { return {_data, _stride, 0}; }
+        __MICROGRADPP_NO_DISCARD__ const_iterator end() const { return {_data, _stride, _size}; }
+
+        __MICROGRADPP_NO_DISCARD__ size_t size() const { return _size; }
+        __MICROGRADPP_NO_DISCARD__ bool empty() const { return _size == 0; }
+        __MICROGRADPP_NO_DISCARD__ size_t stride() const { return _stride; }
+
+        /**
+         * @brief Returns the owners of the viewed nodes, or nullptr if the viewed container
+         * does not own any (e.g. a std::vector<ValueRef>).
+         */
+        __MICROGRADPP_NO_DISCARD__ const Owner* owner() const { return _owner; }
+
+        /**
+         * @brief Accesses an element with bounds checking.
+         * @param idx The index of the element.
+         * @return A handle to the element.
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        ValueRef operator[](const size_t idx) const {
+            return this->at(idx);
+        }
+
+        /**
+         * @brief Accesses an element with bounds checking.
+         * @param idx The index of the element.
+         * @return A handle to the element.
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        __MICROGRADPP_NO_DISCARD__
+        ValueRef at(const size_t idx) const {
+            if (idx >= _size) {
+                throw std::out_of_range("Accessing TensorView out of bounds");
+            }
+            return _data[idx * _stride];
+        }
+
+        /**
+         * @brief Views every `step`-th element of this view, starting at `first`.
+         * @param first Index of the first element.
+         * @param count Number of elements.
+         * @param step Distance between the selected elements, in elements of this view.
+         * @return The narrowed view.
+         * @throws std::out_of_range If the selection does not fit in the view.
+         */
+        __MICROGRADPP_NO_DISCARD__
+        _TensorView slice(size_t first, size_t count, size_t step = 1) const {
+            if (count > 0 && (step == 0 || first + (count - 1) * step >= _size)) {
+                throw std::out_of_range("Accessing TensorView out of bounds");
+            }
+            return {_data + first * _stride, count, _stride * step, _owner};
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const _TensorView& view) {
+            for (const auto& value : view) {
+                os << value;
+            }
+            return os;
+        }
+    };
+
+    /**
+     * @class _ColumnView
+     * @brief A non-owning view of one column of a Tensor2D, stepping over its rows.
+     *
+     * Like _TensorView it never copies handles and does not keep the tensor alive. Rows of a
+     * Tensor2D are separate buffers, so a column cannot be a plain strided pointer; build a
+     * Tensor1D from it to pass it to a layer. Unlike a row view it carries no owners, so the
+     * Tensor2D must outlive a Tensor1D built from one of its columns.
+     *
+     * @tparam Row The row type of the tensor (Tensor1D).
+     */
+    template<class Row>
+    class _ColumnView {
+    public:
+        using ValueRef = typename Row::ValueRef; ///< Handle type of the elements.
+
+        /**
+         * @brief Forward iterator stepping down the rows.
+         */
+        class const_iterator {
+        private:
+            const Row* _row;
+            size_t _column;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ValueRef;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const ValueRef*;
+            using reference = const ValueRef&;
+
+            const_iterator(const Row* row, size_t column) : _row(row), _column(column) {}
+
+            reference operator*() const { return _row->data()[_column]; }
+            pointer operator->() const { return _row->data() + _column; }
+
+            const_iterator& operator++() {
+                ++_row;
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator previous = *this;
+                ++_row;
+                return previous;
+            }
+
+            bool operator==(const const_iterator& other) const { return _row == other._row; }
+            bool operator!=(const const_iterator& other) const { return _row != other._row; }
+        };
+        using iterator = const_iterator; ///< Views are read-only.
+
+    private:
+        const Row* _rows = nullptr; ///< First row.
+        size_t _size = 0;           ///< Number of rows.
+        size_t _column = 0;         ///< Index of the column in each row.
+
+    public:
+        _ColumnView() = default;
+
+        /**
+         * @brief Views element `column` of `size` consecutive rows.
+         */
+        _ColumnView(const Row* rows, size_t size, size_t column) : _rows(rows), _size(size), _column(column) {}
+
+        __MICROGRADPP_NO_DISCARD__ const_iterator begin() const { return {_rows, _column}; }
+        __MICROGRADPP_NO_DISCARD__ const_iterator end() const { return {_rows + _size, _column}; }
+
+        __MICROGRADPP_NO_DISCARD__ size_t size() const { return _size; }
+        __MICROGRADPP_NO_DISCARD__ bool empty() const { return _size == 0; }
+
+        /**
+         * @brief Accesses the element of one row with bounds checking.
+         * @param idx The index of the row.
+         * @return A handle to the element.
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        ValueRef operator[](const size_t idx) const {
+            if (idx >= _size) {
+                throw std::out_of_range("Accessing ColumnView out of bounds");
+            }
+            return _rows[idx].data()[_column];
+        }
+    };
+
     // Internal Use
     /**
      * @class _Tensor1D
-     * @brief A class representing a 1D tensor (vector) of ValuePtr objects.
+     * @brief A class representing a 1D tensor (vector) of ValueRef handles.
      *
      * This class provides methods for tensor operations, including zeroing gradients,
-     * accessing elements, and pushing back new values.
+     * accessing elements, and pushing back new values. Long-lived values pushed as a
+     * ValuePtr are kept alive by the tensor (and its copies) through a single shared owner,
+     * so copying or indexing the tensor never touches per-element reference counts. Tensors
+     * built from a buffer of numbers create their values as one Value::Block instead.
      *
-     * @tparam T The type of tensor (e.g., std::vector<ValuePtr>).
+     * @tparam T The type of tensor (e.g., std::vector<ValueRef>).
      */
     template<class T>
     class _Tensor1D : public BaseTensor<T>{
+    public:
+        using ValueRef = typename T::value_type;             ///< Handle type of the elements.
+        using Value = typename ValueRef::Node;               ///< Node type of the elements.
+        using ValuePtr = typename Value::Ptr;                ///< Owning pointer to an element.
+        using Compute = typename Value::Compute;             ///< Type the elements compute in.
+        using Block = typename Value::Block;                 ///< Owner of values created in bulk.
+        using Owner = _TensorOwner<ValueRef>;                ///< Owners of the long-lived elements.
+
+    private:
+        Owner _owner; ///< Long-lived values owned by this tensor.
+
     public:
 
         _Tensor1D() = default;
 
         /**
-            * @brief Constructs a 1D tensor from a vector of floats.
-            * @param input The vector of floats to initialize the tensor.
+            * @brief Constructs a 1D tensor from a vector of numbers.
+            * @param input The vector of numbers to initialize the tensor.
         */
-        explicit _Tensor1D(const std::vector<float>& input){
-            this->tensor.reserve(input.size());
-            for (const auto& value : input){
-                this->tensor.emplace_back(Value::create(value));
+        explicit _Tensor1D(const std::vector<Compute>& input)
+                : _Tensor1D(input.data(), input.size()) {}
+
+        /**
+         * @brief Constructs a 1D tensor from a buffer of numbers.
+         *
+         * The values are created as one Value::Block, so the cost does not include an
+         * allocation per element. The buffer is only read.
+         *
+         * @param data The numbers.
+         * @param size The number of elements.
+         */
+        _Tensor1D(const Compute* data, size_t size)
+                : _Tensor1D(Value::createBlock(data, size), 0, size) {}
+
+        /**
+         * @brief Constructs a 1D tensor over part of a block, sharing its ownership.
+         * @param block The values, created with Value::createBlock().
+         * @param first Index of the first element in the block.
+         * @param size The number of elements.
+         * @throws std::out_of_range If the elements are not all in the block.
+         */
+        _Tensor1D(std::shared_ptr<const Block> block, size_t first, size_t size) {
+            if (first + size > block->size()) {
+                throw std::out_of_range("Accessing a Value::Block out of bounds");
+            }
+            this->tensor.reserve(size);
+            for (size_t idx = first; idx < first + size; ++idx) {
+                this->tensor.push_back((*block)[idx]);
+            }
+            _owner.block = std::move(block);
+        }
+
+        /**
+         * @brief Constructs a 1D tensor holding the handles of a view.
+         *
+         * A _TensorView of a Tensor1D shares the ownership of its nodes with the new tensor,
+         * which then stays valid after the viewed one is gone. A _ColumnView copies the
+         * handles only (see _ColumnView).
+         *
+         * @tparam View A range of ValueRef (_TensorView or _ColumnView).
+         * @param view The elements to copy.
+         */
+        template<class View, class = std::enable_if_t<
+                std::is_same_v<typename View::ValueRef, ValueRef> && !std::is_same_v<View, _Tensor1D>>>
+        explicit _Tensor1D(const View& view) {
+            this->tensor.reserve(view.size());
+            this->tensor.insert(this->tensor.end(), view.begin(), view.end());
+            if constexpr (std::is_same_v<View, _TensorView<ValueRef>>) {
+                if (view.owner()) {
+                    _owner = *view.owner();
+                }
             }
         }
 
+        /**
+         * @brief Returns the owners of the long-lived elements, shared by views of the tensor.
+         */
+        __MICROGRADPP_NO_DISCARD__
+        const Owner& owner() const {
+            return _owner;
+        }
+
         /**
              * @brief Overloads the output stream operator for printing the tensor.
              * @param os The output stream.
@@ -186,7 +524,7 @@ namespace microgradpp {
              * @param idx The index of the element to access.
              * @return A pointer to the accessed Value.
          */
-        ValuePtr operator[](const size_t idx) const {
+        ValueRef operator[](const size_t idx) const {
             return accessElement(idx);
         }
 
@@ -196,24 +534,44 @@ namespace microgradpp {
          * @return A pointer to the accessed Value.
          */
         __MICROGRADPP_NO_DISCARD__
-                ValuePtr at(const size_t idx) const {
+                ValueRef at(const size_t idx) const {
             return accessElement(idx);
         }
 
         /**
-         * @brief Pushes a new ValuePtr onto the tensor.
+         * @brief Pushes a new ValueRef onto the tensor.
+         * @param value The ValueRef to push back.
+         */
+        void push_back(const ValueRef& value) {
+            this->tensor.emplace_back(value);
+        }
+
+        /**
+         * @brief Pushes a long-lived value onto the tensor and keeps it alive with the tensor.
          * @param value The ValuePtr to push back.
          */
         void push_back(const ValuePtr& value) {
+            if (!_owner.owned) {
+                _owner.owned = std::make_shared<std::vector<ValuePtr>>();
+            }
+            _owner.owned->push_back(value);
             this->tensor.emplace_back(value);
         }
 
         /**
-         * @brief Emplaces a new ValuePtr onto the tensor.
+         * @brief Emplaces a new ValueRef onto the tensor.
+         * @param value The ValueRef to emplace back.
+         */
+        void emplace_back(const ValueRef& value) {
+            this->push_back(value);
+        }
+
+        /**
+         * @brief Emplaces a long-lived value onto the tensor and keeps it alive with the tensor.
          * @param value The ValuePtr to emplace back.
          */
         void emplace_back(const ValuePtr& value) {
-            this->tensor.emplace_back(value);
+            this->push_back(value);
         }
     private:
         /**
@@ -222,7 +580,7 @@ namespace microgradpp {
        * @return A pointer to the accessed Value.
        * @throws std::out_of_range if the index is out of bounds.
        */
-        ValuePtr accessElement(size_t idx) const {
+        ValueRef accessElement(size_t idx) const {
             if (idx >= this->tensor.size()) {
                 throw std::out_of_range("Accessing Tensor1D out of bounds");
             }
@@ -232,33 +590,38 @@ namespace microgradpp {
     };
 
 
-    // Type trait for extracting std::vector<ValuePtr> from T
+    // Type trait for extracting std::vector<ValueRef> from T
     template<typename T>
     struct ExtractValuePtrVector {
-        using type = std::vector<ValuePtr>; // Default type if not matched
+        using type = std::vector<ValueRef>; // Default type if not matched
     };
 
     // Specialization for _Tensor1D types
     template<typename U>
     struct ExtractValuePtrVector<std::vector<_Tensor1D<std::vector<U>>>> {
-    using type = _Tensor1D<std::vector<ValuePtr>>;
+    using type = _Tensor1D<std::vector<U>>;
 };
 
 
     // Internal Use
     /**
      * @class _Tensor2D
-     * @brief A class representing a 2D tensor (matrix) of ValuePtr objects.
+     * @brief A class representing a 2D tensor (matrix) of ValueRef handles.
      *
      * This class provides methods for tensor operations, including zeroing gradients,
      * accessing elements, and pushing back new rows of tensors.
      *
-     * @tparam T The type of tensor (e.g., std::vector<ValuePtr>).
+     * @tparam T The type of tensor (e.g., std::vector<Tensor1D>).
      */
     template<class T>
     class _Tensor2D : public BaseTensor<T> {
     public:
         using Tensor1D_t = typename ExtractValuePtrVector<T>::type; ///< Type alias for 1D tensor.
+        using ValueRef = typename Tensor1D_t::ValueRef;     ///< Handle type of the elements.
+        using Value = typename Tensor1D_t::Value;           ///< Node type of the elements.
+        using Compute = typename Tensor1D_t::Compute;       ///< Type the elements compute in.
+        using RowView = _TensorView<ValueRef>;              ///< Non-owning view of a row.
+        using ColumnView = _ColumnView<Tensor1D_t>;         ///< Non-owning view of a column.
 
         _Tensor2D() = default;
 
@@ -266,23 +629,45 @@ namespace microgradpp {
        * @brief Constructs a 2D tensor from an initializer list of initializer lists.
        * @param input The initializer list of initializer lists to initialize the tensor.
        */
-        _Tensor2D(const std::initializer_list<std::initializer_list<float>>& input) {
+        _Tensor2D(const std::initializer_list<std::initializer_list<Compute>>& input) {
+            std::vector<Compute> values;
             for (const auto& list : input) {
-                Tensor1D_t subTensor;
-                for (auto& value : list) {
-                    subTensor.emplace_back(Value::create(value));
-                }
-                this->tensor.emplace_back(subTensor);
+                values.insert(values.end(), list.begin(), list.end());
+            }
+            const auto block = Value::createBlock(values.data(), values.size());
+            this->tensor.reserve(input.size());
+            size_t first = 0;
+            for (const auto& list : input) {
+                this->tensor.emplace_back(block, first, list.size());
+                first += list.size();
+            }
+        }
+
+        /**
+         * @brief Constructs a 2D tensor from a row-major buffer of numbers.
+         *
+         * All values are created as one Value::Block shared by the rows, so loading a batch
+         * costs one allocation per row instead of one per element. The buffer is only read.
+         *
+         * @param data The numbers, `rows * columns` of them.
+         * @param rows The number of rows.
+         * @param columns The number of columns.
+         */
+        _Tensor2D(const Compute* data, size_t rows, size_t columns) {
+            const auto block = Value::createBlock(data, rows * columns);
+            this->tensor.reserve(rows);
+            for (size_t row = 0; row < rows; ++row) {
+                this->tensor.emplace_back(block, row * columns, columns);
             }
         }
 
         // Constructor for a vector of initializer lists of doubles
         // make a flattened Tensor
         /**
-         * @brief Constructs a 2D tensor from a vector of floats, making a flattened tensor.
-         * @param input The vector of floats to initialize the tensor.
+         * @brief Constructs a 2D tensor from a vector of numbers, making a flattened tensor.
+         * @param input The vector of numbers to initialize the tensor.
          */
-        _Tensor2D(const std::vector<float>& input) {
+        _Tensor2D(const std::vector<Compute>& input) {
             Tensor1D_t subTensor(input);
             this->tensor.emplace_back(subTensor);
         }
@@ -311,7 +696,7 @@ namespace microgradpp {
          * @brief Zeros the gradients of all elements in the 2D tensor.
          *
          * This method iterates through each sub-tensor (row) and sets the gradient
-         * of each ValuePtr to zero. This is typically used before starting a new
+         * of each value to zero. This is typically used before starting a new
          * forward/backward pass in training a neural network to ensure gradients
          * from the previous pass do not affect the current calculations.
          */
@@ -326,21 +711,48 @@ namespace microgradpp {
         /**
          * @brief Accesses a row in the 2D tensor using the index operator.
          *
-         * This method returns a Tensor1D_t object representing a specific row
-         * in the 2D tensor. If the provided index is out of bounds, an
+         * This method returns a reference to the Tensor1D_t object representing a
+         * specific row in the 2D tensor. If the provided index is out of bounds, an
          * std::invalid_argument exception is thrown.
          *
          * @param idx The index of the row to access.
-         * @return A Tensor1D_t object corresponding to the specified row.
+         * @return A reference to the Tensor1D_t object corresponding to the specified row.
          * @throws std::invalid_argument If the index is out of bounds.
          */
-                Tensor1D_t operator[](const size_t idx) const {
+                const Tensor1D_t& operator[](const size_t idx) const {
                     if (this->tensor.size() <= idx) {
                         throw std::invalid_argument("Accessing a Tensor out of bounds");
                     }
                     return this->tensor[idx];
                 }
 
+        /**
+         * @brief Returns a non-owning view of a row.
+         * @param idx The index of the row.
+         * @return A view of the row, valid while the row is.
+         * @throws std::invalid_argument If the index is out of bounds.
+         */
+                __MICROGRADPP_NO_DISCARD__
+                RowView row(const size_t idx) const {
+                    return this->operator[](idx);
+                }
+
+        /**
+         * @brief Returns a non-owning view of a column.
+         * @param jdx The index of the column.
+         * @return A view of the column, valid while the tensor is not resized.
+         * @throws std::invalid_argument If a row is shorter than `jdx + 1`.
+         */
+                __MICROGRADPP_NO_DISCARD__
+                ColumnView column(const size_t jdx) const {
+                    for (const auto& row : this->tensor) {
+                        if (row.size() <= jdx) {
+                            throw std::invalid_argument("Accessing a Tensor out of bounds");
+                        }
+                    }
+                    return {this->tensor.data(), this->tensor.size(), jdx};
+                }
+
         /**
          * @brief Accesses an element in the 2D tensor using the at method.
          *
@@ -354,7 +766,7 @@ namespace microgradpp {
          * @throws std::invalid_argument If the indices are out of bounds.
          */
                 __MICROGRADPP_NO_DISCARD__
-                        ValuePtr at(const size_t idx, const size_t jdx = 0) const {
+                        ValueRef at(const size_t idx, const size_t jdx = 0) const {
                     if (this->tensor.size() <= idx || this->tensor[idx].size() <= jdx) {
                         throw std::invalid_argument("Accessing a Tensor out of bounds");
                     }
@@ -390,8 +802,25 @@ namespace microgradpp {
     };
 
 
-    typedef _Tensor1D<std::vector<ValuePtr>> Tensor1D;
-    typedef _Tensor2D<std::vector<Tensor1D>> Tensor2D; // std::vector<std::vector<ValuePtr>>
+    template<class S>
+    using BasicTensor1D = _Tensor1D<std::vector<BasicValueRef<S>>>;
+    template<class S>
+    using BasicTensor2D = _Tensor2D<std::vector<BasicTensor1D<S>>>;
+
+    template<class S>
+    using BasicTensorView = _TensorView<BasicValueRef<S>>;
+
+    typedef BasicTensor1D<float> Tensor1D;
+    typedef BasicTensor2D<float> Tensor2D; // std::vector<std::vector<ValueRef>>
+    typedef BasicTensorView<float> TensorView;
+
+#ifdef MICROGRADPP_EXTERN_TEMPLATES
+    // Instantiated once in src/ScalarInstantiations.cpp
+    extern template class _Tensor1D<std::vector<BasicValueRef<double>>>;
+    extern template class _Tensor1D<std::vector<BasicValueRef<bfloat16>>>;
+    extern template class _Tensor2D<std::vector<BasicTensor1D<double>>>;
+    extern template class _Tensor2D<std::vector<BasicTensor1D<bfloat16>>>;
+#endif
 
 
     class Tensor {
@@ -32,6 +32,7 @@
  */
 
 #pragma once
+#include <atomic>
 #include <cstdio>
 #include <vector>
 #include <string>
@@ -40,16 +41,16 @@
 #include <algorithm>
 #include <cmath>
 #include <memory>
-#include <functional> // std::function
 #include <iomanip>
+#include <stdexcept>
+#ifdef MICROGRADPP_DEBUG_METADATA
+#include <cassert>
+#endif
 
 // m++ headers
 #include "Autograd.hpp"
 
 namespace microgradpp {
-    class Value;
-    /// Global instance of Autograd to manage the computation tape
-    Autograd Autograd::global_tape;
 
     /**
     * @brief Custom hash function for std::shared_ptr<Value> to allow its use in unordered containers.
@@ -60,74 +61,259 @@ namespace microgradpp {
         * @param value A shared pointer to a Value object.
         * @return A size_t representing the hash value.
         */
-        size_t operator()(const std::shared_ptr<Value>& value) const;
+        template<class S>
+        size_t operator()(const std::shared_ptr<BasicValue<S>>& value) const {
+            if (!value) {
+                return 0;
+            }
+            return std::hash<const void*>()(value.get());
+        }
     };
 
 
-    using ValuePtr = std::shared_ptr<Value>;
+    template<class S>
+    using BasicValuePtr = std::shared_ptr<BasicValue<S>>;
+
+    using ValuePtr = BasicValuePtr<float>;
+
+    /**
+     * @brief A lightweight handle to a node of the computational graph.
+     *
+     * A ValueRef is a 32-bit index into the node storage owned by the tape, so copying it
+     * costs nothing and touches no reference count. Handles to intermediate nodes are valid
+     * until the next `Autograd::clear()`, and only on the tape that created them: the index
+     * is resolved against the calling thread's current tape, so dereferencing one under
+     * another TapeScope reads an unrelated node. Builds with MICROGRADPP_DEBUG_METADATA
+     * remember the tape of each handle and assert this. Handles to long-lived nodes are valid
+     * on every tape as long as a ValuePtr owning the node exists.
+     *
+     * @tparam S The scalar type of the node (see BasicValue).
+     */
+    template<class S>
+    class BasicValueRef {
+    public:
+        using Node = BasicValue<S>;          ///< The node type referred to
+        using Tape = BasicAutograd<Node>;    ///< The tape owning the node
+
+        uint32_t index = Tape::NONE; ///< Index of the node in the tape's storage.
+#ifdef MICROGRADPP_DEBUG_METADATA
+        const Tape* tape = &Tape::current(); ///< Tape the handle was made on, checked when resolved.
+#endif
+
+        BasicValueRef() = default;
+
+        /**
+         * @brief Wraps a node index returned by the tape.
+         * @param index The node index.
+         */
+        explicit BasicValueRef(uint32_t index) : index(index) {}
+
+        /**
+         * @brief Refers to the node owned by a ValuePtr without taking ownership.
+         * @param value The owning pointer.
+         */
+        BasicValueRef(const BasicValuePtr<S>& value);
+
+        Node* get() const;
+        Node* operator->() const;
+        Node& operator*() const;
+
+        explicit operator bool() const {
+            return index != Tape::NONE;
+        }
+
+        bool operator==(const BasicValueRef& other) const {
+            return index == other.index;
+        }
+
+        bool operator!=(const BasicValueRef& other) const {
+            return index != other.index;
+        }
+    };
+
+    using ValueRef = BasicValueRef<float>;
 
     /**
      * @brief A class representing a value in the computational graph with automatic differentiation support.
+     *
+     * A node is a packed 16-byte record. Debug metadata (label, unique id, operands) is not
+     * stored in the node; it lives in the tape's side table when the library is built with
+     * MICROGRADPP_DEBUG_METADATA.
+     *
+     * `Value` is `BasicValue<float>`. Other scalar types store data and gradients as `S` and
+     * compute in `ScalarTraits<S>::Compute`: `BasicValue<double>` for more precision,
+     * `BasicValue<bfloat16>` for half the memory per node with float arithmetic. Nodes of
+     * different scalar types live on different tapes and cannot be mixed in one graph.
+     *
+     * @tparam S The scalar type the node stores.
      */
-    class Value : public std::enable_shared_from_this<Value> {
+    template<class S>
+    class BasicValue {
+    public:
+        using Scalar = S;                                   ///< Type of the stored data and gradient
+        using Compute = typename ScalarTraits<S>::Compute;  ///< Type the operations compute in
+        using Ref = BasicValueRef<S>;                       ///< Handle to a node of this type
+        using Ptr = BasicValuePtr<S>;                       ///< Owning pointer to a node of this type
+        using Tape = BasicAutograd<BasicValue>;             ///< Tape recording nodes of this type
+
     private:
+        template<class, uint32_t> friend class NodeArena;
+        template<class, uint32_t, uint32_t> friend class NodePool;
+
         /**
          * @brief Constructor for Value.
          * @param data The numerical value stored.
-         * @param op The operation used to create this value (optional).
-         * @param id The unique identifier for this value (optional).
+         * @param op The operation used to create this value.
          */
-        explicit Value(float data, std::string op, size_t id)
-                : data(data), grad(0.0), op(std::move(op)), id(id) {}
+        explicit BasicValue(Compute data, OpCode op = OpCode::LEAF)
+                : data(data), grad(0), op(op) {}
 
-        bool gradientFlag = true;  ///< By default gradients are calculated for every operation
     public:
-        inline static size_t currentID = 0; ///< Global counter for generating unique IDs.
-        float data = 0; ///< The actual numerical value.
-        float grad = 0; ///< The gradient of the value (used in backpropagation).
-        std::string op; ///< The operation used to create the value (e.g., +, *, etc.).
-        size_t id = 0LU; ///< A unique identifier for the value.
-        std::vector<ValuePtr> prev; ///< Pointers to the previous values that were inputs to this value.
-        std::function<void()> backward = nullptr; ///< Function to compute the gradient during backpropagation.
+        /**
+         * @brief Bits stored in `flags`.
+         */
+        enum Flags : uint8_t {
+            REQUIRES_GRAD = 1 << 0, ///< Gradients are calculated for this value
+            REACHABLE = 1 << 1      ///< Reached from the root during a pruned backward pass
+        };
 
+        inline static std::atomic<size_t> currentID{0}; ///< Global counter for generating unique IDs (debug metadata).
+        static constexpr float GRADIENT_CLIP_VALUE = 1e4; ///< Gradient clipping threshold.
+        static constexpr float EPSILON = 1e-7; ///< Small value to avoid numerical instability.
+
+        S data = 0; ///< The actual numerical value.
+        S grad = 0; ///< The gradient of the value (used in backpropagation).
+        OpCode op = OpCode::LEAF; ///< The operation used to create the value.
+        uint8_t flags = REQUIRES_GRAD; ///< Combination of Flags.
+        uint32_t index = Tape::NONE; ///< Index of this node in the tape's storage.
 
         /**
-        * @brief Generates a new unique ID for each value.
+        * @brief Generates a new unique ID for each value. Safe to call from any thread.
         * @return A size_t representing the unique ID.
         */
         static size_t generateID() {
-            return ++currentID;
+            return currentID.fetch_add(1, std::memory_order_relaxed) + 1;
         }
 
         /**
-         * @brief Factory method to create a new Value instance.
+         * @brief Factory method to create a new long-lived Value instance.
+         *
+         * The value is allocated from the tape's long-lived pool and survives
+         * `Tape::clear()`; use it for parameters and input data.
+         *
          * @param data The numerical value stored.
-         * @param op The operation used to create this value (optional).
-         * @param id The unique identifier for this value (optional).
          * @return A shared pointer to the created Value.
          */
-        static ValuePtr create(float data, std::string op = ""){
-            return std::shared_ptr<Value>(new Value(data,  std::move(op), generateID()));
+        static Ptr create(Compute data){
+            auto& tape = Tape::current();
+            return {&tape.node(tape.createPersistent(data)),
+                    [](BasicValue* value) { Tape::releasePersistent(value->index); }};
         }
 
         /**
-           * @brief Destructor for Value.
-        */
-        ~Value(){
-            --currentID;
+         * @brief Factory method for an intermediate Value of the current graph.
+         *
+         * The value is allocated from the tape's arena and is released by the next
+         * `Tape::clear()`; handles to it must not be kept past that call.
+         *
+         * @param data The numerical value stored.
+         * @param op The operation used to create this value (optional).
+         * @return A handle to the created Value.
+         */
+        static Ref createTransient(Compute data, OpCode op = OpCode::LEAF){
+            return Ref(Tape::current().createNode(data, op));
+        }
+
+        /**
+         * @brief Long-lived values created together by createBlock() and released together
+         * when the last owner of the block goes away.
+         */
+        class Block {
+        private:
+            uint32_t _first; ///< Index of the first node; the others follow it
+            size_t _size;    ///< Number of nodes
+
+        public:
+            Block(uint32_t first, size_t size) : _first(first), _size(size) {}
+
+            Block(const Block&) = delete;
+            Block& operator=(const Block&) = delete;
+
+            ~Block() {
+                release(_first, _size);
+            }
+
+            __MICROGRADPP_NO_DISCARD__ size_t size() const { return _size; }
+
+            Ref operator[](size_t idx) const { return Ref(_first + static_cast<uint32_t>(idx)); }
+
+            /**
+             * @brief Releases `size` consecutive long-lived nodes starting at `first`.
+             */
+            static void release(uint32_t first, size_t size) noexcept {
+                for (size_t idx = 0; idx < size; ++idx) {
+                    Tape::releasePersistent(first + static_cast<uint32_t>(idx));
+                }
+            }
+        };
+
+        /**
+         * @brief Factory method for many long-lived values sharing one owner.
+         *
+         * Unlike calling create() per element, no owner is allocated per value: the values
+         * take consecutive pool slots reserved under a single lock, and the block costs a
+         * constant number of allocations however many values it holds.
+         *
+         * @param data The values, in order.
+         * @param size The number of values.
+         * @return The owner of the created values.
+         * @throws std::length_error If the pool cannot hold `size` more values.
+         */
+        static std::shared_ptr<const Block> createBlock(const Compute* data, size_t size) {
+            if (size > Tape::PERSISTENT) {
+                throw std::length_error("Error in microgradpp::Value::createBlock -> too many values");
+            }
+            const auto count = static_cast<uint32_t>(size);
+            const uint32_t first = count > 0 ? Tape::current().createPersistentRange(data, count) : Tape::PERSISTENT;
+            try {
+                return std::make_shared<const Block>(first, size);
+            } catch (...) {
+                Block::release(first, size);
+                throw;
+            }
         }
 
-        std::string label; ///< A label for the value (optional).
-        inline static int labelIdx = 0; ///< Global counter for labels.
+        /**
+         * @brief Sets the label of the value. Only recorded with MICROGRADPP_DEBUG_METADATA.
+         * @param label The label.
+         */
+        void setLabel(std::string label) {
+#ifdef MICROGRADPP_DEBUG_METADATA
+            Tape::current().metadata[index].label = std::move(label);
+#else
+            (void)label;
+#endif
+        }
 
-        const float GRADIENT_CLIP_VALUE = 1e4; ///< Gradient clipping threshold.
-        const float EPSILON = 1e-7; ///< Small value to avoid numerical instability.
+        /**
+         * @brief Returns the label of the value, or an empty string without MICROGRADPP_DEBUG_METADATA.
+         */
+        __MICROGRADPP_NO_DISCARD__
+        std::string label() const {
+#ifdef MICROGRADPP_DEBUG_METADATA
+            auto& metadata = Tape::current().metadata;
+            const auto it = metadata.find(index);
+            return it == metadata.end() ? std::string() : it->second.label;
+#else
+            return {};
+#endif
+        }
 
         /**
             * @brief Switches off gradient calculation
         */
         void setGradientFlag(){
-
+            flags &= static_cast<uint8_t>(~REQUIRES_GRAD);
         }
 
         /**
@@ -145,7 +331,6 @@ namespace microgradpp {
         void reset(){
             this->grad = 0.0;
             this->data = 0.0;
-            this->prev.clear();
         }
 
         /**
@@ -160,45 +345,30 @@ namespace microgradpp {
         ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
         /**
           * @brief Adds two values and creates a new value.
-          * @param lhs The left-hand side ValuePtr.
-          * @param rhs The right-hand side ValuePtr.
-          * @return A shared pointer to the new Value representing the sum.
+          * @param lhs The left-hand side ValueRef.
+          * @param rhs The right-hand side ValueRef.
+          * @return A handle to the new Value representing the sum.
           */
-        static ValuePtr add(const ValuePtr& lhs, const ValuePtr& rhs) {
-            auto out = create((float)(lhs->data + rhs->data), "+");
-            out->prev = {lhs, rhs};
-
-            Autograd::global_tape.add_entry(out, [lhs_weak = std::weak_ptr<Value>(lhs), rhs_weak = std::weak_ptr<Value>(rhs), out_weak = std::weak_ptr<Value>(out)]() {
-                //if (auto lhs = lhs_weak.lock()) {
-                lhs_weak.lock()->grad += out_weak.lock()->grad;
-                //}
-                //if (auto rhs = rhs_weak.lock()) {
-                rhs_weak.lock()->grad += out_weak.lock()->grad;
-                //}
-            });
+        static Ref add(const Ref& lhs, const Ref& rhs) {
+            auto out = createTransient(static_cast<Compute>(lhs->data) + rhs->data, OpCode::ADD);
+
+            Tape::current().add_entry(OpCode::ADD, out.index, lhs.index, rhs.index);
 
             return out;
         }
 
         /**
-         * @brief Adds a value and a float.
-         * @param lhs The left-hand side ValuePtr.
-         * @param f The float to add.
-         * @return A shared pointer to the new Value representing the sum.
+         * @brief Adds a value and a constant.
+         *
+         * The constant is stored in the tape record; no node is created for it.
+         * @param lhs The left-hand side ValueRef.
+         * @param f The constant to add.
+         * @return A handle to the new Value representing the sum.
          */
-        static ValuePtr add(const ValuePtr& lhs, float f) {
-            auto rhs = Value::create((float)f);
-            auto out = create((float)(lhs->data + f), "+");
-            out->prev = {lhs, rhs};
-
-            Autograd::global_tape.add_entry(out, [lhs_weak = std::weak_ptr<Value>(lhs), rhs_weak = std::weak_ptr<Value>(rhs), out_weak = std::weak_ptr<Value>(out)]() {
-                //if (auto lhs = lhs_weak.lock()) {
-                lhs_weak.lock()->grad += out_weak.lock()->grad;
-                //}
-                //if (auto rhs = rhs_weak.lock()) {
-                rhs_weak.lock()->grad += out_weak.lock()->grad;
-                //}
-            });
+        static Ref add(const Ref& lhs, Compute f) {
+            auto out = createTransient(static_cast<Compute>(lhs->data) + f, OpCode::ADD_CONST);
+
+            Tape::current().add_entry(OpCode::ADD_CONST, out.index, lhs.index, Tape::NONE, f);
 
             return out;
         }
@@ -210,44 +380,29 @@ namespace microgradpp {
 
         /**
           * @brief Multiplies two values and creates a new value.
-          * @param lhs The left-hand side ValuePtr.
-          * @param rhs The right-hand side ValuePtr.
-          * @return A shared pointer to the new Value representing the product.
+          * @param lhs The left-hand side ValueRef.
+          * @param rhs The right-hand side ValueRef.
+          * @return A handle to the new Value representing the product.
           */
-        static ValuePtr multiply(const ValuePtr& lhs, const ValuePtr& rhs) {
-            auto out = create((float)(lhs->data * rhs->data), "*");
-            out->prev = {lhs, rhs};
-
-            Autograd::global_tape.add_entry(out,[lhs_weak = std::weak_ptr<Value>(lhs), rhs_weak = std::weak_ptr<Value>(rhs), out_weak = std::weak_ptr<Value>(out)]() {
-                //if (auto lhs = lhs_weak.lock()) {
-                lhs_weak.lock()->grad += rhs_weak.lock()->data * out_weak.lock()->grad;
-                //}
-                //if (auto rhs = rhs_weak.lock()) {
-                rhs_weak.lock()->grad += lhs_weak.lock()->data * out_weak.lock()->grad;
-                //}
-            });
+        static Ref multiply(const Ref& lhs, const Ref& rhs) {
+            auto out = createTransient(static_cast<Compute>(lhs->data) * rhs->data, OpCode::MULTIPLY);
+
+            Tape::current().add_entry(OpCode::MULTIPLY, out.index, lhs.index, rhs.index);
             return out;
         }
 
         /**
-           * @brief Multiplies a value and a float.
-           * @param lhs The left-hand side ValuePtr.
-           * @param f The float to multiply.
-           * @return A shared pointer to the new Value representing the product.
+           * @brief Multiplies a value and a constant.
+           *
+           * The constant is stored in the tape record; no node is created for it.
+           * @param lhs The left-hand side ValueRef.
+           * @param f The constant to multiply.
+           * @return A handle to the new Value representing the product.
            */
-        static ValuePtr multiply(const ValuePtr& lhs, float f) {
-            auto rhs = create(f);
-            auto out = create((float)(lhs->data * f), "*");
-            out->prev = {lhs, rhs};
-
-            Autograd::global_tape.add_entry(out,[lhs_weak = std::weak_ptr<Value>(lhs), rhs_weak = std::weak_ptr<Value>(rhs), out_weak = std::weak_ptr<Value>(out)]() {
-                //if (auto lhs = lhs_weak.lock()) {
-                lhs_weak.lock()->grad += rhs_weak.lock()->data * out_weak.lock()->grad;
-                //}
-                //if (auto rhs = rhs_weak.lock()) {
-                rhs_weak.lock()->grad += lhs_weak.lock()->data * out_weak.lock()->grad;
-                //}
-            });
+        static Ref multiply(const Ref& lhs, Compute f) {
+            auto out = createTransient(static_cast<Compute>(lhs->data) * f, OpCode::MUL_CONST);
+
+            Tape::current().add_entry(OpCode::MUL_CONST, out.index, lhs.index, Tape::NONE, f);
             return out;
         }
 
@@ -257,20 +412,16 @@ namespace microgradpp {
         ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
         /**
          * @brief Raises a value to the power of an exponent.
-         * @param base The base ValuePtr.
-         * @param exponent The float exponent.
-         * @return A shared pointer to the new Value representing the result.
+         * @param base The base ValueRef.
+         * @param exponent The exponent.
+         * @return A handle to the new Value representing the result.
          */
-        static ValuePtr pow(const ValuePtr& base, float exponent) {
-            float newValue = std::pow(base->data, exponent);
-            auto out = create(newValue, "^");
-            out->prev = {base};
-
-            Autograd::global_tape.add_entry(out,[base_weak = std::weak_ptr<Value>(base), out_weak = std::weak_ptr<Value>(out), exponent]() {
-                if (auto base = base_weak.lock()) {
-                    base->grad += exponent * std::pow(base->data, exponent - 1) * out_weak.lock()->grad;
-                }
-            });
+        static Ref pow(const Ref& base, Compute exponent) {
+            using std::pow; // Dual overloads are found by ADL
+            Compute newValue = pow(static_cast<Compute>(base->data), exponent);
+            auto out = createTransient(newValue, OpCode::POW);
+
+            Tape::current().add_entry(OpCode::POW, out.index, base.index, Tape::NONE, exponent);
 
             return out;
         }
@@ -279,22 +430,22 @@ namespace microgradpp {
         // Division
         ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
         /**
-         * @brief Divides a value by a float.
-         * @param lhs The left-hand side ValuePtr.
-         * @param otherValue The float divisor.
-         * @return A shared pointer to the new Value representing the quotient.
+         * @brief Divides a value by a constant, as a multiplication by its reciprocal.
+         * @param lhs The left-hand side ValueRef.
+         * @param otherValue The divisor.
+         * @return A handle to the new Value representing the quotient.
          */
-        static ValuePtr divide ( const std::shared_ptr<Value>& lhs, float otherValue) {
-            return multiply(lhs , std::pow(otherValue, -1.0f));
+        static Ref divide( const Ref& lhs, Compute otherValue) {
+            return multiply(lhs, Compute(1) / otherValue);
         }
 
         /**
         * @brief Divides a value by a float.
-        * @param lhs The left-hand side ValuePtr.
-        * @param rhs The right-hand side ValuePtr.
-        * @return A shared pointer to the new Value representing the quotient.
+        * @param lhs The left-hand side ValueRef.
+        * @param rhs The right-hand side ValueRef.
+        * @return A handle to the new Value representing the quotient.
         */
-        static ValuePtr divide(const ValuePtr& lhs, const ValuePtr& rhs) {
+        static Ref divide(const Ref& lhs, const Ref& rhs) {
             auto reciprocal = pow(rhs, -1);
             return multiply(lhs, reciprocal);
         }
@@ -304,47 +455,26 @@ namespace microgradpp {
         ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
         /**
        * @brief Subtracts two values and creates a new value.
-       * @param lhs The left-hand side ValuePtr.
-       * @param rhs The right-hand side ValuePtr.
-       * @return A shared pointer to the new Value representing the difference.
+       * @param lhs The left-hand side ValueRef.
+       * @param rhs The right-hand side ValueRef.
+       * @return A handle to the new Value representing the difference.
        */
-        static ValuePtr subtract(const ValuePtr& lhs, const ValuePtr& rhs) {
-            auto out = create((float)(lhs->data - rhs->data), "-");
-            out->prev = {lhs, rhs};
-
-            Autograd::global_tape.add_entry(out,[lhs_weak = std::weak_ptr<Value>(lhs), rhs_weak = std::weak_ptr<Value>(rhs), out_weak = std::weak_ptr<Value>(out)]() {
-                //if (auto lhs = lhs_weak.lock()) {
-                lhs_weak.lock()->grad += out_weak.lock()->grad;
-                //}
-                //if (auto rhs = rhs_weak.lock()) {
-                rhs_weak.lock()->grad -= out_weak.lock()->grad;
-                //}
-            });
+        static Ref subtract(const Ref& lhs, const Ref& rhs) {
+            auto out = createTransient(static_cast<Compute>(lhs->data) - rhs->data, OpCode::SUBTRACT);
+
+            Tape::current().add_entry(OpCode::SUBTRACT, out.index, lhs.index, rhs.index);
 
             return out;
         }
 
         /**
-       * @brief Subtracts two values and creates a new value.
-       * @param lhs The left-hand side ValuePtr.
-       * @param f float
-       * @return A shared pointer to the new Value representing the difference.
+       * @brief Subtracts a constant from a value, as an addition of its negation.
+       * @param lhs The left-hand side ValueRef.
+       * @param f The constant to subtract.
+       * @return A handle to the new Value representing the difference.
        */
-        static ValuePtr subtract(const ValuePtr& lhs, float f) {
-            auto rhs = create(f);
-            auto out = create((float)(lhs->data - rhs->data), "-");
-            out->prev = {lhs, rhs};
-
-            Autograd::global_tape.add_entry(out,[lhs_weak = std::weak_ptr<Value>(lhs), rhs_weak = std::weak_ptr<Value>(rhs), out_weak = std::weak_ptr<Value>(out)]() {
-                //if (auto lhs = lhs_weak.lock()) {
-                lhs_weak.lock()->grad += out_weak.lock()->grad;
-                //}
-                //if (auto rhs = rhs_weak.lock()) {
-                rhs_weak.lock()->grad -= out_weak.lock()->grad;
-                //}
-            });
-
-            return out;
+        static Ref subtract(const Ref& lhs, Compute f) {
+            return add(lhs, -f);
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -352,57 +482,114 @@ namespace microgradpp {
         ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
         /**
        * @brief Applies the tanh activation function.
-       * @param v The input ValuePtr.
-       * @return A shared pointer to the new Value representing the tanh output.
+       * @param v The input ValueRef.
+       * @return A handle to the new Value representing the tanh output.
        */
-        static ValuePtr tanh(const ValuePtr& v) {
-            float x = v->data;
-            float t = (std::exp(2 * x) - 1) / (std::exp(2 * x) + 1);
-            auto out = create(t, "tanh");
-            out->prev = {v};
+        static Ref tanh(const Ref& v) {
+            Compute x = v->data;
+            using std::exp;
+            Compute t = (exp(2 * x) - 1) / (exp(2 * x) + 1);
+            auto out = createTransient(t, OpCode::TANH);
 
-            Autograd::global_tape.add_entry(out,[v_weak = std::weak_ptr<Value>(v), t, out_weak = std::weak_ptr<Value>(out)]() {
-                v_weak.lock()->grad += (1 - t * t) * out_weak.lock()->grad;
-            });
+            Tape::current().add_entry(OpCode::TANH, out.index, v.index, Tape::NONE, t);
 
             return out;
         }
 
         /**
          * @brief Applies the ReLU activation function.
-         * @param v The input ValuePtr.
-         * @return A shared pointer to the new Value representing the ReLU output.
+         * @param v The input ValueRef.
+         * @return A handle to the new Value representing the ReLU output.
          */
-        static ValuePtr relu(const ValuePtr& v) {
-            float val = std::max(0.0f, v->data);
-            auto out = create(val, "ReLU");
-            out->prev = {v};
+        static Ref relu(const Ref& v) {
+            Compute val = std::max<Compute>(0, v->data);
+            auto out = createTransient(val, OpCode::RELU);
 
-            Autograd::global_tape.add_entry(out,[v_weak = std::weak_ptr<Value>(v), out_weak = std::weak_ptr<Value>(out)]() {
-                if (v_weak.lock()) {
-                    v_weak.lock()->grad += static_cast<float>((out_weak.lock()->data > 0)) * out_weak.lock()->grad;
-                };
-            });
+            Tape::current().add_entry(OpCode::RELU, out.index, v.index);
 
             return out;
         }
 
+        /**
+         * @brief Applies ReLU to every element of a range as a single tape record.
+         *
+         * The record keeps one bit per element for backward instead of reading the
+         * outputs (see OpCode::RELU_MASK).
+         *
+         * @tparam X A range of Ref (e.g. Tensor1D).
+         * @tparam Y A container of Ref with push_back (e.g. Tensor1D).
+         * @param inputs The inputs.
+         * @param outputs Receives the outputs, appended in order.
+         */
+        template<class X, class Y>
+        static void relu(const X& inputs, Y& outputs) {
+            thread_local std::vector<uint32_t> inputIndices, outputIndices;
+            inputIndices.clear();
+            outputIndices.clear();
+            for (const auto& x : inputs) {
+                auto out = createTransient(std::max<Compute>(0, x->data), OpCode::RELU_MASK);
+                inputIndices.push_back(x.index);
+                outputIndices.push_back(out.index);
+                outputs.push_back(out);
+            }
+            Tape::current().add_relu_mask_entry(inputIndices.data(), outputIndices.data(),
+                                                static_cast<uint32_t>(inputIndices.size()));
+        }
+
         /**
            * @brief Applies the sigmoid activation function.
-           * @param v The input ValuePtr.
-           * @return A shared pointer to the new Value representing the sigmoid output.
+           * @param v The input ValueRef.
+           * @return A handle to the new Value representing the sigmoid output.
         */
-        static ValuePtr sigmoid(const ValuePtr& v) {
-            float x = v->data;
-            float t = std::exp(x) / (1 + std::exp(x));
-            auto out = create(t, "Sigmoid");
-            out->prev = {v};
+        static Ref sigmoid(const Ref& v) {
+            Compute x = v->data;
+            using std::exp;
+            Compute t = exp(x) / (1 + exp(x));
+            auto out = createTransient(t, OpCode::SIGMOID);
+
+            Tape::current().add_entry(OpCode::SIGMOID, out.index, v.index, Tape::NONE, t);
 
-            Autograd::global_tape.add_entry(out,[v_weak = std::weak_ptr<Value>(v), t, out_weak = std::weak_ptr<Value>(out)]() {
-                v_weak.lock()->grad += t * (1 - t) * out_weak.lock()->grad;
-                //v_weak.lock()->clip_gradients();
-            });
+            return out;
+        }
 
+        ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Dot product
+        ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        /**
+         * @brief Computes `sum(weights[i] * inputs[i]) + bias` as a single graph node.
+         *
+         * The whole product is one tape record whose backward rule writes every weight and
+         * input gradient in one loop, instead of a multiply and an add node per term.
+         *
+         * @tparam W A range of ValueRef (e.g. Tensor1D).
+         * @tparam X A range of ValueRef (e.g. Tensor1D).
+         * @param weights The weights.
+         * @param inputs The inputs, same length as the weights.
+         * @param bias The bias.
+         * @return A handle to the new Value representing the result.
+         * @throws std::invalid_argument If the ranges differ in length.
+         */
+        template<class W, class X>
+        static Ref dot(const W& weights, const X& inputs, const Ref& bias) {
+            if (weights.size() != inputs.size()) {
+                throw std::invalid_argument("Error in micrograd::Value::dot -> Vectors must be of the same length");
+            }
+            thread_local std::vector<uint32_t> weightIndices, inputIndices;
+            weightIndices.clear();
+            inputIndices.clear();
+
+            Compute sum = 0;
+            auto input = inputs.begin();
+            for (const auto& weight : weights) {
+                const Ref x = *input++;
+                sum += static_cast<Compute>(x->data) * weight->data;
+                weightIndices.push_back(weight.index);
+                inputIndices.push_back(x.index);
+            }
+            auto out = createTransient(sum + bias->data, OpCode::DOT);
+
+            Tape::current().add_dot_entry(out.index, weightIndices.data(), inputIndices.data(),
+                                                static_cast<uint32_t>(weightIndices.size()), bias.index);
             return out;
         }
 
@@ -429,15 +616,28 @@ namespace microgradpp {
         }
         /**
             * @brief Initiates the backward pass by setting the gradient of the output value to 1.
+            * Only the tape records this value depends on are replayed.
         */
         void _backward() {
             grad = 1.0f;
-            Autograd::global_tape.backward();
+            Tape::current().backward(index);
+        }
+
+        /**
+         * @brief Back-propagates like backProp(), running independent records on several cores.
+         *
+         * Worth it for wide graphs such as large layers or batches; see
+         * `BasicTape::backwardParallel()`. Gradients are the same as with backProp() up
+         * to the order in which contributions are summed.
+         */
+        void backPropParallel() {
+            grad = 1.0f;
+            Tape::current().backwardParallel(index);
         }
 
 //        /**
 //         * @brief Builds the topological order of the computational graph.
-//         * @param v The input ValuePtr.
+//         * @param v The input ValueRef.
 //         * @param visited A set to track visited nodes.
 //         * @param topo The topologically sorted output values.
 //         */
@@ -451,26 +651,52 @@ namespace microgradpp {
 //            }
 //        }
 
-        bool operator==(const Value& other) const;
+        bool operator==(const BasicValue& other) const {
+            return data == other.data && op == other.op;
+        }
 
-        friend std::ostream & operator << (std::ostream &os, const std::shared_ptr<Value> &v){
+        friend std::ostream & operator << (std::ostream &os, const Ptr &v){
             os << "[data: " << std::setw(3) << v->data << ", grad: " << std::setw(3) << v->grad << "] ";
             return os;
         }
-    };
 
+        friend std::ostream & operator << (std::ostream &os, const Ref &v){
+            os << "[data: " << std::setw(3) << v->data << ", grad: " << std::setw(3) << v->grad << "] ";
+            return os;
+        }
+    };
 
+    static_assert(sizeof(Value) == 16, "Value is expected to be a packed 16-byte node");
+
+#ifdef MICROGRADPP_EXTERN_TEMPLATES
+    // Instantiated once in src/ScalarInstantiations.cpp
+    extern template class BasicValue<double>;
+    extern template class BasicValue<bfloat16>;
+    extern template class BasicValueRef<double>;
+    extern template class BasicValueRef<bfloat16>;
+    extern template class BasicAutograd<BasicValue<double>>;
+    extern template class BasicAutograd<BasicValue<bfloat16>>;
+#endif
+
+    template<class S>
+    inline BasicValueRef<S>::BasicValueRef(const BasicValuePtr<S>& value) : index(value->index) {}
+
+    template<class S>
+    inline BasicValue<S>* BasicValueRef<S>::get() const {
+#ifdef MICROGRADPP_DEBUG_METADATA
+        assert(((index & Tape::PERSISTENT) || tape == &Tape::current())
+               && "Error in microgradpp::ValueRef -> intermediate node resolved on another tape");
+#endif
+        return &Tape::current().node(index);
+    }
 
-    size_t Hash::operator()(const std::shared_ptr<Value>& value) const {
-        if (!value) {
-            return 0;
-        }
-        return std::hash<const void*>()(value.get());
+    template<class S>
+    inline BasicValue<S>* BasicValueRef<S>::operator->() const {
+        return get();
     }
 
-    bool Value::operator==(const Value& other) const {
-        return data == other.data && op == other.op && prev == other.prev;
+    template<class S>
+    inline BasicValue<S>& BasicValueRef<S>::operator*() const {
+        return *get();
     }
 }
-
-
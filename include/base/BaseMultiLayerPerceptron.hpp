@@ -38,6 +38,7 @@
 #pragma once
 
 #include "core/Sequential.hpp"
+#include "GraphPlan.hpp"
 #include "TypeDefs.hpp"
 
 using microgradpp::core::Sequential;
@@ -52,9 +53,20 @@ namespace microgradpp::base {
  * It encapsulates a `Sequential` object, which contains a series of neural network layers,
  * and provides methods to print parameters, reset gradients, and update parameters.
  * Derived classes must implement the `forward` method to define the forward pass logic.
+ *
+ * @tparam S The scalar type of the model (see BasicValue).
  */
-    class BaseMultiLayerPerceptron {
-
+    template<class S>
+    class BasicMultiLayerPerceptron {
+    public:
+        using Sequential = core::BasicSequential<S>;                ///< Layer sequence type.
+        using Tensor1D = BasicTensor1D<S>;                          ///< Vector of nodes.
+        using Tensor2D = BasicTensor2D<S>;                          ///< Matrix of nodes.
+        using TensorView = BasicTensorView<S>;                      ///< Non-owning view of nodes.
+        using Compute = typename BasicValue<S>::Compute;            ///< Type the model computes in.
+        using BaseMultiLayerPerceptron = BasicMultiLayerPerceptron; ///< Lets derived classes name their base as before.
+
+    private:
         /// Internal `Sequential` object managing layers in the MLP.
         Sequential _baseSequential;
 
@@ -66,7 +78,7 @@ namespace microgradpp::base {
          * @brief Constructs the MLP base class with a given `Sequential` layer sequence.
          * @param sequential A `Sequential` object containing the layer sequence for the MLP.
          */
-        BaseMultiLayerPerceptron(const Sequential& sequential) : _baseSequential(sequential) {}
+        BasicMultiLayerPerceptron(const Sequential& sequential) : _baseSequential(sequential) {}
 
         /**
          * @brief Prints information about the model's layer sequence.
@@ -96,25 +108,61 @@ namespace microgradpp::base {
             this->_baseSequential.update(this->learningRate);
         }
 
+        /**
+         * @brief Adds the parameter gradients of one micro-batch and discards its graph.
+         *
+         * Gives the gradients of a large batch with the memory of one micro-batch: call
+         * `zeroGrad()`, then `accumulate()` for every micro-batch, then `update()`.
+         *
+         * @param xs Inputs of the micro-batch, one row per sample.
+         * @param ys Targets of the micro-batch.
+         * @param lossFcn The loss function.
+         * @param scale Factor applied to the loss gradient, e.g. 1 / number of micro-batches.
+         * @return The loss of the micro-batch.
+         */
+        Compute accumulate(const Tensor2D& xs, const Tensor2D& ys, AbstractLoss<Tensor2D>& lossFcn, Compute scale = 1) {
+            return accumulateGradients([this](TensorView input) { return this->forward(input); },
+                                       xs, ys, lossFcn, scale);
+        }
+
         /**
          * @brief Invokes the forward pass of the MLP for a given input.
-         * @param input The input tensor of shape 1D.
+         * @param input The input tensor of shape 1D, or a view of one.
          * @return The output tensor after the forward pass.
          */
-        Tensor1D operator()(const Tensor1D& input) {
+        Tensor1D operator()(TensorView input) {
             return this->forward(input);
         }
 
+        /**
+         * @brief Captures one forward pass over `xs` and the loss against `ys` into a reusable plan.
+         *
+         * The plan replays the same graph with new data of the same shape without creating
+         * nodes, see GraphPlan. The model must outlive the plan. Only float models can be captured.
+         *
+         * @param xs Inputs with the shape every replay will use.
+         * @param ys Targets with the shape every replay will use.
+         * @param lossFcn The loss function.
+         * @return The captured plan.
+         */
+        GraphPlan capture(const Tensor2D& xs, const Tensor2D& ys, AbstractLoss<Tensor2D>& lossFcn) {
+            static_assert(std::is_same_v<S, float>, "GraphPlan records float graphs only");
+            return GraphPlan::capture([this](TensorView input) { return this->forward(input); },
+                                      xs, ys, lossFcn);
+        }
+
         /**
          * @brief Pure virtual method for the forward pass, to be implemented in derived classes.
-         * @param input Input tensor for the forward pass.
+         * @param input Input tensor for the forward pass; a view, so rows of a dataset are not copied.
          * @return Output tensor after processing the input through the MLP layers.
          */
-        virtual Tensor1D forward(Tensor1D input) = 0;
+        virtual Tensor1D forward(TensorView input) = 0;
 
     protected:
         /// Learning rate used during the parameter update step.
-        float learningRate = 0.001;
+        Compute learningRate = 0.001;
     };
 
+    using BaseMultiLayerPerceptron = BasicMultiLayerPerceptron<float>;
+
 } // namespace microgradpp::base
@@ -27,7 +27,9 @@
  *  @details
  *  The `CoreLinear` class provides functionality for a single linear (fully connected) layer
  *  in a neural network, using neurons as its basic units. It offers methods for forward
- *  computation, parameter management, and gradient resetting.
+ *  computation, parameter management, and gradient resetting. A single sample is computed
+ *  as one dot product per neuron; `forwardBatch` computes a whole batch of float samples
+ *  as one matrix product per direction (see Gemm.hpp).
  */
 
 #pragma once
@@ -36,8 +38,11 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <stdexcept>
+#include <type_traits>
 
 // microgradpp libraries
+#include "Gemm.hpp"
 #include "MppCore.hpp"
 #include "Neuron.hpp"
 #include "Value.hpp"
@@ -51,12 +56,22 @@ namespace microgradpp::core {
      *
      * The `CoreLinear` class is derived from `MppCore` and implements the forward operation,
      * zero gradient function, and parameter retrieval for a linear neural network layer.
+     *
+     * @tparam S The scalar type of the weights (see BasicValue).
      */
-    class CoreLinear : public MppCore {
+    template<class S>
+    class BasicCoreLinear : public BasicMppCore<S> {
+    public:
+        using Value = BasicValue<S>;            ///< Node type of the layer.
+        using Tensor1D = BasicTensor1D<S>;      ///< Vector of nodes.
+        using TensorView = BasicTensorView<S>;  ///< Non-owning view of nodes.
+        using Tensor2D = BasicTensor2D<S>;      ///< Matrix of nodes, one row per sample.
+        using Tape = BasicAutograd<Value>;      ///< Tape the layer records on.
+
     private:
         size_t _nin;           /**< Number of input neurons */
         size_t _nout;          /**< Number of output neurons */
-        std::vector<Neuron> _neurons; /**< Vector containing neuron objects for the layer */
+        std::vector<BasicNeuron<S>> _neurons; /**< Vector containing neuron objects for the layer */
 
     public:
         /**
@@ -64,7 +79,7 @@ namespace microgradpp::core {
          * @param nin Number of inputs to each neuron.
          * @param nout Number of neurons (output size).
          */
-        CoreLinear(size_t nin, size_t nout): _nin(nin), _nout(nout){
+        BasicCoreLinear(size_t nin, size_t nout): _nin(nin), _nout(nout){
             for(size_t idx = 0; idx < nout; ++idx){
                 this->_neurons.emplace_back(nin);
             }
@@ -72,18 +87,118 @@ namespace microgradpp::core {
 
         /**
          * @brief Performs the forward pass of the linear layer using input tensor.
-         * @param x Input tensor of size `nin`.
+         * @param x Input tensor, or a view of one, of size `nin`.
          * @return Tensor1D Output tensor of size `nout` after applying each neuron's forward pass.
          */
-        Tensor1D operator()(const Tensor1D& x) override {
+        Tensor1D operator()(TensorView x) override {
             Tensor1D out;
             out.reserve(this->_neurons.size());
-            std::for_each(this->_neurons.begin(), this->_neurons.end(), [&out, x=x](   auto neuron)mutable{
+            for(auto& neuron : this->_neurons){
                 out.emplace_back(neuron(x));
-            });
+            }
             return out;
         }
 
+        /**
+         * @brief Performs the forward pass of the linear layer on a batch of samples.
+         *
+         * For float layers the batch X is evaluated as Y = X W^T + b with one packed matrix
+         * product and recorded as a single tape entry whose backward rule computes
+         * dX = dY W and dW = dY^T X the same way. Other scalar types apply the layer
+         * row by row.
+         *
+         * @param xs Input tensor, one row of size `nin` per sample.
+         * @return Tensor2D Output tensor, one row of size `nout` per sample.
+         * @throws std::invalid_argument If a row is not of size `nin`.
+         */
+        Tensor2D forwardBatch(const Tensor2D& xs) override {
+            if constexpr (!std::is_same_v<S, float>) {
+                return BasicMppCore<S>::forwardBatch(xs);
+            } else {
+                const size_t batch = xs.size();
+                std::vector<float> x(batch * _nin), w(_nout * _nin), y(batch * _nout);
+                std::vector<uint32_t> inputs;
+                inputs.reserve(x.size() + w.size() + _nout);
+                for (size_t row = 0; row < batch; ++row) {
+                    if (xs[row].size() != _nin) {
+                        throw std::invalid_argument("Error in microgradpp::CoreLinear -> Input rows must be of size nin");
+                    }
+                    for (size_t col = 0; col < _nin; ++col) {
+                        const auto& value = xs[row][col];
+                        x[row * _nin + col] = value->data;
+                        inputs.push_back(value.index);
+                    }
+                }
+                for (size_t out = 0; out < _nout; ++out) {
+                    const auto& weights = _neurons[out].getWeights();
+                    for (size_t col = 0; col < _nin; ++col) {
+                        w[out * _nin + col] = weights[col]->data;
+                        inputs.push_back(weights[col].index);
+                    }
+                }
+                for (size_t out = 0; out < _nout; ++out) {
+                    const auto bias = _neurons[out].getBias();
+                    for (size_t row = 0; row < batch; ++row) {
+                        y[row * _nout + out] = bias->data;
+                    }
+                    inputs.push_back(bias.index);
+                }
+                gemm::sgemm(false, true, batch, _nout, _nin, x.data(), _nin, w.data(), _nin, y.data(), _nout);
+
+                // Outputs are TENSOR nodes only when the record below is added
+                const bool record = Tape::isGradEnabled();
+                Tensor2D result;
+                result.reserve(batch);
+                std::vector<uint32_t> outputs;
+                outputs.reserve(y.size());
+                for (size_t row = 0; row < batch; ++row) {
+                    Tensor1D values;
+                    values.reserve(_nout);
+                    for (size_t out = 0; out < _nout; ++out) {
+                        auto node = Value::createTransient(y[row * _nout + out], record ? OpCode::TENSOR : OpCode::LEAF);
+                        outputs.push_back(node.index);
+                        values.push_back(node);
+                    }
+                    result.push_back(values);
+                }
+                if (!record) {
+                    return result;
+                }
+
+                // The closure reads the node indices from its own record, on the tape that recorded it
+                Tape& tape = Tape::current();
+                const size_t op = tape.tensorOps.size();
+                auto backward = [&tape, op, x = std::move(x), w = std::move(w), batch, nin = _nin, nout = _nout]() {
+                    const std::vector<uint32_t>& inputs = tape.tensorOps[op].inputs;
+                    const std::vector<uint32_t>& outputs = tape.tensorOps[op].outputs;
+                    std::vector<float> dy(outputs.size());
+                    for (size_t idx = 0; idx < outputs.size(); ++idx) {
+                        dy[idx] = tape.node(outputs[idx]).grad;
+                    }
+                    std::vector<float> dx(batch * nin, 0.0f), dw(nout * nin, 0.0f), db(nout, 0.0f);
+                    gemm::sgemm(false, false, batch, nin, nout, dy.data(), nout, w.data(), nin, dx.data(), nin);
+                    gemm::sgemm(true, false, nout, nin, batch, dy.data(), nout, x.data(), nin, dw.data(), nin);
+                    for (size_t row = 0; row < batch; ++row) {
+                        for (size_t out = 0; out < nout; ++out) {
+                            db[out] += dy[row * nout + out];
+                        }
+                    }
+                    size_t next = 0;
+                    for (const float grad : dx) {
+                        tape.node(inputs[next++]).grad += grad;
+                    }
+                    for (const float grad : dw) {
+                        tape.node(inputs[next++]).grad += grad;
+                    }
+                    for (const float grad : db) {
+                        tape.node(inputs[next++]).grad += grad;
+                    }
+                };
+                tape.add_tensor_op({std::move(inputs), std::move(outputs), std::move(backward)});
+                return result;
+            }
+        }
+
         /**
          * @brief Prints layer information, displaying the input-output dimensions.
          */
@@ -125,9 +240,17 @@ namespace microgradpp::core {
             printf("Num parameters: %d\n", (int)params.size());
             for(const auto& p : params){
                 std::cout<< &p << " ";
-                printf("[data=%f,grad=%lf]\n", p->data, p->grad);
+                printf("[data=%f,grad=%lf]\n", static_cast<double>(p->data), static_cast<double>(p->grad));
             }
             printf("\n");
         }
     };
+
+    using CoreLinear = BasicCoreLinear<float>;
+
+#ifdef MICROGRADPP_EXTERN_TEMPLATES
+    // Instantiated once in src/ScalarInstantiations.cpp
+    extern template class BasicCoreLinear<double>;
+    extern template class BasicCoreLinear<bfloat16>;
+#endif
 }
@@ -48,9 +48,15 @@ namespace microgradpp::core {
      *
      * The `CoreReLU` class is a layer that applies the ReLU activation function
      * element-wise to an input tensor, setting all negative values to zero.
+     *
+     * @tparam S The scalar type of the nodes (see BasicValue).
      */
-    class CoreReLU : public MppCore {
+    template<class S>
+    class BasicCoreReLU : public BasicMppCore<S> {
     public:
+        using Value = BasicValue<S>;            ///< Node type of the layer.
+        using Tensor1D = BasicTensor1D<S>;      ///< Vector of nodes.
+        using TensorView = BasicTensorView<S>;  ///< Non-owning view of nodes.
 
         /**
          * @brief Prints layer information, displaying that this is a ReLU layer.
@@ -64,20 +70,27 @@ namespace microgradpp::core {
         /**
          * @brief Applies the ReLU activation function to each element in the input tensor.
          *
-         * Uses the ReLU function, defined in the `Activation` class, to process each
-         * element in the input tensor. This is achieved by iterating through the tensor
-         * and replacing negative values with zero while keeping positive values unchanged.
+         * Replaces negative values with zero while keeping positive values unchanged. The
+         * whole layer is one tape record that saves a 1-bit mask per element for backward
+         * (see `Value::relu(inputs, outputs)`), so backward does not depend on the output
+         * values.
          *
          * @param in Input tensor for which ReLU activation is applied.
          * @return Tensor1D Output tensor where each element is the result of applying ReLU to the corresponding input element.
          */
-        Tensor1D operator()(const Tensor1D& in) override {
-            const auto& activationFcn = Activation::mActivationFcn.at(ActivationType::RELU);
+        Tensor1D operator()(TensorView in) override {
             Tensor1D out;
-            for(const auto& value : in) {
-                out.push_back(activationFcn(value));
-            }
+            out.reserve(in.size());
+            Value::relu(in, out);
             return out;
         }
     };
+
+    using CoreReLU = BasicCoreReLU<float>;
+
+#ifdef MICROGRADPP_EXTERN_TEMPLATES
+    // Instantiated once in src/ScalarInstantiations.cpp
+    extern template class BasicCoreReLU<double>;
+    extern template class BasicCoreReLU<bfloat16>;
+#endif
 }
@@ -48,9 +48,15 @@ namespace microgradpp::core {
      *
      * The `CoreReLU` class is a layer that applies the ReLU activation function
      * element-wise to an input tensor, setting all negative values to zero.
+     *
+     * @tparam S The scalar type of the nodes (see BasicValue).
      */
-    class CoreTanH : public MppCore {
+    template<class S>
+    class BasicCoreTanH : public BasicMppCore<S> {
     public:
+        using Value = BasicValue<S>;            ///< Node type of the layer.
+        using Tensor1D = BasicTensor1D<S>;      ///< Vector of nodes.
+        using TensorView = BasicTensorView<S>;  ///< Non-owning view of nodes.
 
         /**
          * @brief Prints layer information, displaying that this is a ReLU layer.
@@ -71,8 +77,8 @@ namespace microgradpp::core {
          * @param in Input tensor for which ReLU activation is applied.
          * @return Tensor1D Output tensor where each element is the result of applying ReLU to the corresponding input element.
          */
-        Tensor1D operator()(const Tensor1D& in) override {
-            const auto& activationFcn = Activation::mActivationFcn.at(ActivationType::TANH);
+        Tensor1D operator()(TensorView in) override {
+            const auto& activationFcn = BasicActivation<S>::mActivationFcn.at(ActivationType::TANH);
             Tensor1D out;
             for(const auto& value : in) {
                 out.push_back(activationFcn(value));
@@ -80,4 +86,12 @@ namespace microgradpp::core {
             return out;
         }
     };
+
+    using CoreTanH = BasicCoreTanH<float>;
+
+#ifdef MICROGRADPP_EXTERN_TEMPLATES
+    // Instantiated once in src/ScalarInstantiations.cpp
+    extern template class BasicCoreTanH<double>;
+    extern template class BasicCoreTanH<bfloat16>;
+#endif
 }
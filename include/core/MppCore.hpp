@@ -39,6 +39,7 @@
 
 // microgradpp libraries
 #include "Value.hpp"
+#include "Tensor.hpp"
 #include "TypeDefs.hpp"
 
 namespace microgradpp::core {
@@ -51,9 +52,16 @@ namespace microgradpp::core {
      * It defines essential functions for neural network layers, including parameter
      * management, gradient resetting, and forward computation, which must be implemented
      * by any class that inherits from `MppCore`.
+     *
+     * @tparam S The scalar type of the layer's nodes (see BasicValue).
      */
-    class MppCore {
+    template<class S>
+    class BasicMppCore {
     public:
+        using Value = BasicValue<S>;            ///< Node type of the layer.
+        using Tensor1D = BasicTensor1D<S>;      ///< Vector of nodes.
+        using TensorView = BasicTensorView<S>;  ///< Non-owning view of nodes.
+        using Tensor2D = BasicTensor2D<S>;      ///< Matrix of nodes, one row per sample.
 
         /**
          * @brief Default constructor for `MppCore`.
@@ -61,7 +69,7 @@ namespace microgradpp::core {
          * Provides a default constructor that allows derived classes to initialize
          * without specifying additional parameters.
          */
-        MppCore() = default;
+        BasicMppCore() = default;
 
         /**
          * @brief Pure virtual function to print layer information.
@@ -77,10 +85,28 @@ namespace microgradpp::core {
          * Processes the input tensor and returns the output tensor by performing
          * the layer's specific operation. Must be implemented by derived classes.
          *
-         * @param in Input tensor.
+         * @param in Input tensor, or a view of one (e.g. a row of a Tensor2D).
          * @return Tensor1D Output tensor after applying the layer's computation.
          */
-        virtual Tensor1D operator()(const Tensor1D& in) = 0;
+        virtual Tensor1D operator()(TensorView in) = 0;
+
+        /**
+         * @brief Forward computation of a whole batch.
+         *
+         * Applies the layer to every row by default. Layers that can process the batch at
+         * once (see CoreLinear) override it.
+         *
+         * @param in Input tensor, one row per sample.
+         * @return Tensor2D Output tensor, one row per sample.
+         */
+        virtual Tensor2D forwardBatch(const Tensor2D& in) {
+            Tensor2D out;
+            out.reserve(in.size());
+            for (const auto& row : in) {
+                out.push_back(this->operator()(row));
+            }
+            return out;
+        }
 
         /**
          * @brief Resets gradients for all parameters in the layer.
@@ -111,4 +137,6 @@ namespace microgradpp::core {
             return {};
         }
     };
+
+    using MppCore = BasicMppCore<float>;
 }
@@ -34,12 +34,14 @@
 #pragma once
 
 // Standard libraries
+#include <algorithm>
 #include <vector>
 #include <memory>
 
 // microgradpp libraries
 #include "CoreReLU.hpp"
 #include "CoreLinear.hpp"
+#include "GradientAccumulation.hpp"
 #include "TypeDefs.hpp"
 
 namespace microgradpp::core {
@@ -52,11 +54,27 @@ namespace microgradpp::core {
      * sequence, providing functionality for forward propagation, parameter access,
      * gradient updates, and zeroing. This class is essential for constructing
      * feedforward neural networks in the microgradpp library.
+     *
+     * @tparam S The scalar type of the layers (see BasicValue).
      */
-    class Sequential {
+    template<class S>
+    class BasicSequential {
+    public:
+        using Value = BasicValue<S>;                ///< Node type of the layers.
+        using ValueRef = BasicValueRef<S>;          ///< Handle to a node.
+        using Tensor1D = BasicTensor1D<S>;          ///< Vector of nodes.
+        using Tensor2D = BasicTensor2D<S>;          ///< Matrix of nodes, one row per sample.
+        using TensorView = BasicTensorView<S>;      ///< Non-owning view of nodes.
+        using Compute = typename Value::Compute;    ///< Type the layers compute in.
+        using Tape = BasicAutograd<Value>;          ///< Tape the layers record on.
+        using Layer = BasicMppCore<S>;              ///< Layer type of the sequence.
+
     private:
         /// Sequence of neural network layers.
-        std::vector<std::shared_ptr<MppCore>> _layerSequence;
+        std::vector<std::shared_ptr<Layer>> _layerSequence;
+
+        /// Number of layers per checkpointed segment, 0 when checkpointing is off.
+        size_t _checkpointEvery = 0;
 
     public:
 
@@ -66,25 +84,95 @@ namespace microgradpp::core {
          * @param layerSequence A vector of shared pointers to `MppCore` objects representing
          * the neural network layers to be stacked sequentially.
          */
-        Sequential(std::vector<std::shared_ptr<MppCore>> layerSequence)
+        BasicSequential(std::vector<std::shared_ptr<Layer>> layerSequence)
                 : _layerSequence(std::move(layerSequence)) {};
 
         /**
          * @brief Performs forward propagation through the sequence of layers.
          *
          * Iteratively applies each layer in the sequence to the input, passing the result
-         * from one layer as the input to the next.
+         * from one layer as the input to the next. In inference mode (see NoGradGuard)
+         * the intermediate nodes of the pass are released before returning, so only
+         * the output nodes remain.
          *
-         * @param input The input tensor for the network.
+         * @param input The input tensor for the network, or a view of one. It is passed to
+         *        the first layer as is, so a row of a Tensor2D is never copied.
          * @return Tensor1D The output tensor after passing through all layers.
          */
-        Tensor1D operator()(const Tensor1D& input) {
-            auto result = input;
-            for(auto& layer : _layerSequence){
-                auto out = layer->operator()(result);
-                result = out;
+        Tensor1D operator()(TensorView input) {
+            if (!Tape::isGradEnabled()) {
+                return this->infer(input);
             }
-            return result;
+            // A captured GraphPlan replays plain records only
+            if (_checkpointEvery > 0 && !Tape::current().captured && !_layerSequence.empty()) {
+                Tensor1D result = this->checkpoint(input, 0, std::min(_checkpointEvery, _layerSequence.size()));
+                for (size_t first = _checkpointEvery; first < _layerSequence.size(); first += _checkpointEvery) {
+                    result = this->checkpoint(result, first, std::min(first + _checkpointEvery, _layerSequence.size()));
+                }
+                return result;
+            }
+            return this->run(input, 0, _layerSequence.size());
+        }
+
+        /**
+         * @brief Performs forward propagation of a whole batch through the sequence of layers.
+         *
+         * Each layer processes all rows at once (see MppCore::forwardBatch), so linear
+         * layers run as matrix products instead of one dot product per sample and neuron.
+         * Checkpointed models and captured plans go sample by sample through operator().
+         *
+         * @param inputs The input tensor, one row per sample.
+         * @return Tensor2D The output tensor, one row per sample.
+         */
+        Tensor2D forwardBatch(const Tensor2D& inputs) {
+            if (_checkpointEvery > 0 || Tape::current().captured) {
+                Tensor2D result;
+                result.reserve(inputs.size());
+                for (const auto& input : inputs) {
+                    result.push_back(this->operator()(input));
+                }
+                return result;
+            }
+            if (Tape::isGradEnabled()) {
+                return this->runBatch(inputs);
+            }
+
+            auto& arena = Tape::current().arena;
+            const uint32_t mark = arena.size();
+            std::vector<std::vector<Compute>> values;
+            for (const auto& row : this->runBatch(inputs)) {
+                values.emplace_back();
+                for (const auto& value : row) {
+                    values.back().push_back(value->data);
+                }
+            }
+            arena.rewind(mark);
+
+            Tensor2D out;
+            out.reserve(values.size());
+            for (const auto& row : values) {
+                Tensor1D result;
+                result.reserve(row.size());
+                for (const Compute value : row) {
+                    result.push_back(Value::createTransient(value));
+                }
+                out.push_back(result);
+            }
+            return out;
+        }
+
+        /**
+         * @brief Enables gradient checkpointing.
+         *
+         * The layers are split into segments of `layersPerSegment` layers. The forward pass
+         * keeps only the outputs of each segment; the activations inside a segment are
+         * recomputed when the backward pass reaches it. This trades one extra forward pass
+         * for memory that no longer grows with the depth of the model.
+         *
+         * @param layersPerSegment Layers per segment, 0 to disable checkpointing.
+         */
+        void setCheckpointing(size_t layersPerSegment) {
+            _checkpointEvery = layersPerSegment;
         }
 
         /**
@@ -116,12 +204,29 @@ namespace microgradpp::core {
          *
          * @param learningRate The learning rate to apply for each parameter update.
          */
-        void update(float learningRate) {
+        void update(Compute learningRate) {
             for (auto &p: this->parameters()) {
-                p->data += (float)((float)-learningRate * (float)p->grad);
+                p->data += -static_cast<Compute>(learningRate) * static_cast<Compute>(p->grad);
             }
         }
 
+        /**
+         * @brief Adds the parameter gradients of one micro-batch and discards its graph.
+         *
+         * Call `zeroGrad()`, then once per micro-batch, then `update()`; see
+         * accumulateGradients().
+         *
+         * @param xs Inputs of the micro-batch, one row per sample.
+         * @param ys Targets of the micro-batch.
+         * @param lossFcn The loss function.
+         * @param scale Factor applied to the loss gradient.
+         * @return The loss of the micro-batch.
+         */
+        Compute accumulate(const Tensor2D& xs, const Tensor2D& ys, AbstractLoss<Tensor2D>& lossFcn, Compute scale = 1) {
+            return accumulateGradients([this](TensorView input) { return this->operator()(input); },
+                                       xs, ys, lossFcn, scale);
+        }
+
         /**
          * @brief Prints parameters for each layer in the sequence.
          *
@@ -157,5 +262,121 @@ namespace microgradpp::core {
                 layerSeq->print();
             }
         }
+
+    private:
+        /**
+         * @brief Applies layers [first, last) to the input.
+         *
+         * An empty range returns the input nodes themselves; the result shares their
+         * ownership with the viewed tensor (see _TensorView), so it outlives that tensor.
+         */
+        Tensor1D run(TensorView input, size_t first, size_t last) {
+            if (first == last) {
+                return Tensor1D(input);
+            }
+            Tensor1D result = _layerSequence[first]->operator()(input);
+            for (size_t idx = first + 1; idx < last; ++idx) {
+                result = _layerSequence[idx]->operator()(result);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Applies every layer to a whole batch.
+         */
+        Tensor2D runBatch(const Tensor2D& inputs) {
+            if (_layerSequence.empty()) {
+                return inputs;
+            }
+            Tensor2D result = _layerSequence.front()->forwardBatch(inputs);
+            for (size_t idx = 1; idx < _layerSequence.size(); ++idx) {
+                result = _layerSequence[idx]->forwardBatch(result);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Forward pass of layers [first, last) that keeps only the segment outputs.
+         * @param input The segment input.
+         * @param first Index of the first layer of the segment.
+         * @param last Index one past the last layer of the segment.
+         * @return Tensor1D The segment outputs, recomputed from `input` during backward.
+         */
+        Tensor1D checkpoint(TensorView input, size_t first, size_t last) {
+            auto& arena = Tape::current().arena;
+            std::vector<Compute> values;
+            {
+                NoGradGuard guard;
+                const uint32_t mark = arena.size();
+                for (const auto& value : this->run(input, first, last)) {
+                    values.push_back(value->data);
+                }
+                arena.rewind(mark);
+            }
+
+            Checkpoint segment;
+            segment.inputs.reserve(input.size());
+            for (const auto& value : input) {
+                segment.inputs.push_back(value.index);
+            }
+
+            Tensor1D out;
+            out.reserve(values.size());
+            segment.outputs.reserve(values.size());
+            for (const Compute value : values) {
+                auto node = Value::createTransient(value, OpCode::CHECKPOINT);
+                out.push_back(node);
+                segment.outputs.push_back(node.index);
+            }
+
+            segment.recompute = [this, first, last](const std::vector<uint32_t>& inputs) {
+                Tensor1D in;
+                in.reserve(inputs.size());
+                for (const uint32_t index : inputs) {
+                    in.push_back(ValueRef(index));
+                }
+                std::vector<uint32_t> outputs;
+                for (const auto& value : this->run(in, first, last)) {
+                    outputs.push_back(value.index);
+                }
+                return outputs;
+            };
+            Tape::current().add_checkpoint(std::move(segment));
+            return out;
+        }
+
+        /**
+         * @brief Forward pass without tape recording that frees its intermediate nodes.
+         * @param input The input tensor for the network.
+         * @return Tensor1D The output tensor, the only nodes left in the arena by the pass.
+         */
+        Tensor1D infer(TensorView input) {
+            auto& arena = Tape::current().arena;
+            const uint32_t mark = arena.size();
+
+            Tensor1D result = this->run(input, 0, _layerSequence.size());
+
+            std::vector<Compute> values;
+            values.reserve(result.size());
+            for(const auto& value : result){
+                values.push_back(value->data);
+            }
+            arena.rewind(mark);
+
+            Tensor1D out;
+            out.reserve(values.size());
+            for(const Compute value : values){
+                out.push_back(Value::createTransient(value));
+            }
+            return out;
+        }
     };
+
+    using Sequential = BasicSequential<float>;
+
+#ifdef MICROGRADPP_EXTERN_TEMPLATES
+    // Instantiated once in src/ScalarInstantiations.cpp
+    extern template class BasicSequential<double>;
+    extern template class BasicSequential<bfloat16>;
+#endif
 }
@@ -49,14 +49,15 @@ namespace microgradpp::nn {
      * forwarding for its constructor arguments, ensuring efficient and flexible 
      * initialization.
      *
+     * @tparam S The scalar type of the layer (float unless given, e.g. `Linear<double>(2, 4)`).
      * @tparam T Variadic template parameter pack for constructor arguments.
      * @param args Arguments to be forwarded to the CoreLinear constructor.
-     * @return std::unique_ptr<microgradpp::core::CoreLinear> A unique pointer
+     * @return std::unique_ptr<microgradpp::core::BasicCoreLinear<S>> A unique pointer
      *         to the created CoreLinear layer instance.
      */
-    template <class... T>
-    std::unique_ptr<microgradpp::core::CoreLinear> Linear(T&&... args) {
-        return std::make_unique<microgradpp::core::CoreLinear>(std::forward<T>(args)...);
+    template <class S = float, class... T>
+    std::unique_ptr<microgradpp::core::BasicCoreLinear<S>> Linear(T&&... args) {
+        return std::make_unique<microgradpp::core::BasicCoreLinear<S>>(std::forward<T>(args)...);
     }
 
     /**
@@ -65,11 +66,13 @@ namespace microgradpp::nn {
      * This function constructs a new instance of the `CoreReLU` class without any
      * constructor arguments, returning a unique pointer to the created layer.
      *
-     * @return std::unique_ptr<microgradpp::core::CoreReLU> A unique pointer
+     * @tparam S The scalar type of the layer.
+     * @return std::unique_ptr<microgradpp::core::BasicCoreReLU<S>> A unique pointer
      *         to the created CoreReLU layer instance.
      */
-    std::unique_ptr<microgradpp::core::CoreReLU> ReLU() {
-        return std::make_unique<microgradpp::core::CoreReLU>();
+    template <class S = float>
+    std::unique_ptr<microgradpp::core::BasicCoreReLU<S>> ReLU() {
+        return std::make_unique<microgradpp::core::BasicCoreReLU<S>>();
     }
 
     /**
@@ -78,10 +81,12 @@ namespace microgradpp::nn {
      * This function constructs a new instance of the `CoreTanH` class without any
      * constructor arguments, returning a unique pointer to the created layer.
      *
-     * @return std::unique_ptr<microgradpp::core::CoreTanH> A unique pointer
+     * @tparam S The scalar type of the layer.
+     * @return std::unique_ptr<microgradpp::core::BasicCoreTanH<S>> A unique pointer
      *         to the created CoreTanH layer instance.
      */
-    std::unique_ptr<microgradpp::core::CoreTanH> TanH() {
-        return std::make_unique<microgradpp::core::CoreTanH>();
+    template <class S = float>
+    std::unique_ptr<microgradpp::core::BasicCoreTanH<S>> TanH() {
+        return std::make_unique<microgradpp::core::BasicCoreTanH<S>>();
     }
 }
@@ -94,7 +94,7 @@ namespace microgradpp{
         }
 
 
-         Tensor1D forward(Tensor1D input) override{
+         Tensor1D forward(TensorView input) override{
             // call this->sequence(input) here
             return this->sequential(input);
         };
@@ -0,0 +1,80 @@
+/**
+ *  @file ScalarInstantiations.cpp
+ *  @brief Explicit instantiations of the library templates for double and bfloat16.
+ *
+ *  This file is part of the microgradpp project, a lightweight C++ library for neural
+ *  network training and inference.
+ *
+ *  @section License
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  @section Author
+ *  Gautam Sharma
+ *  Email: gautamsharma2813@gmail.com
+ *  Date: October 16, 2026
+ *
+ *  @details
+ *  The float types are used by every program and stay header-only. The double and bfloat16
+ *  types are compiled here once when the library is configured with
+ *  MICROGRADPP_PRECOMPILED_SCALARS; the headers then declare them `extern template`
+ *  (MICROGRADPP_EXTERN_TEMPLATES), so programs using them do not instantiate the tape,
+ *  the layers and the losses again in every translation unit.
+ */
+
+// microgradpp headers
+#include "Value.hpp"
+#include "Tensor.hpp"
+#include "Neuron.hpp"
+#include "LossFunctions.hpp"
+#include "core/CoreLinear.hpp"
+#include "core/CoreReLU.hpp"
+#include "core/CoreTanH.hpp"
+#include "core/Sequential.hpp"
+
+namespace microgradpp {
+
+    template class BasicValue<double>;
+    template class BasicValue<bfloat16>;
+    template class BasicValueRef<double>;
+    template class BasicValueRef<bfloat16>;
+    template class BasicAutograd<BasicValue<double>>;
+    template class BasicAutograd<BasicValue<bfloat16>>;
+
+    template class _Tensor1D<std::vector<BasicValueRef<double>>>;
+    template class _Tensor1D<std::vector<BasicValueRef<bfloat16>>>;
+    template class _Tensor2D<std::vector<BasicTensor1D<double>>>;
+    template class _Tensor2D<std::vector<BasicTensor1D<bfloat16>>>;
+
+    template class BasicNeuron<double>;
+    template class BasicNeuron<bfloat16>;
+
+    namespace core {
+        template class BasicCoreLinear<double>;
+        template class BasicCoreLinear<bfloat16>;
+        template class BasicCoreReLU<double>;
+        template class BasicCoreReLU<bfloat16>;
+        template class BasicCoreTanH<double>;
+        template class BasicCoreTanH<bfloat16>;
+        template class BasicSequential<double>;
+        template class BasicSequential<bfloat16>;
+    }
+
+    namespace loss {
+        template class BasicMeanSquaredError<double>;
+        template class BasicMeanSquaredError<bfloat16>;
+        template class BasicMeanSquaredErrorFor1DPixels<double>;
+        template class BasicMeanSquaredErrorFor1DPixels<bfloat16>;
+    }
+
+} // namespace microgradpp
@@ -5,7 +5,18 @@
 #include "utils.hpp"
 #include "GradTester.hpp"
 #include "Value.hpp"
+#include "TapeOptimizer.hpp"
+#include "PlanCompiler.hpp"
+#include "GraphPlan.hpp"
+#include "Expression.hpp"
+#include "Tensor.hpp"
+#include "LossFunctions.hpp"
+#include "nn/NeuralNet.hpp"
+#include "core/Sequential.hpp"
+#include "ForwardMode.hpp"
+#include "DenseTensor.hpp"
 #include <chrono>
+#include <thread>
 
 using microgradpp::Value;
 
@@ -18,11 +29,11 @@ using microgradpp::Value;
          auto variables = microgradpp::utils::readVariablesFromJson("test_add_value_output.json");
 
          auto a = Value::create(64);
-         a->label = "a";
+         a->setLabel("a");
          auto b = Value::create(8);
-         b->label = "b";
+         b->setLabel("b");
          auto c = Value::add(a,b);
-         c->label = "c";
+         c->setLabel("c");
          c->backProp();
          microgradpp::GradTester::equals<float>(a->data, variables["a"].data, "testAddValue a data");
          microgradpp::GradTester::equals<float>(a->grad, variables["a"].grad, "testAddValue a grad");
@@ -36,9 +47,9 @@ using microgradpp::Value;
          auto variables = microgradpp::utils::readVariablesFromJson("test_add_constant_output.json");
 
          auto a = Value::create(64);
-         a->label = "a";
+         a->setLabel("a");
          auto b = Value::add(a ,8.90);
-         b->label = "b";
+         b->setLabel("b");
          b->backProp();
 
          microgradpp::GradTester::equals<float>(a->data, variables["a"].data, "testAddConstant a data");
@@ -51,11 +62,11 @@ using microgradpp::Value;
          auto variables = microgradpp::utils::readVariablesFromJson("test_subtract_value_output.json");
 
          auto a = Value::create(64);
-         a->label = "a";
+         a->setLabel("a");
          auto b = Value::create(8);
-         b->label = "b";
+         b->setLabel("b");
          auto c = Value::subtract(a,b);
-         c->label = "c";
+         c->setLabel("c");
          c->backProp();
 
 
@@ -72,9 +83,9 @@ using microgradpp::Value;
          auto variables = microgradpp::utils::readVariablesFromJson("test_subtract_constant_output.json");
 
          auto a = Value::create(64);
-         a->label = "a";
+         a->setLabel("a");
          auto b = Value::subtract(a,8.90);
-         b->label = "b";
+         b->setLabel("b");
          b->backProp();
 
          microgradpp::GradTester::equals<float>(a->data, variables["a"].data, "testSubtractConstant a data");
@@ -88,11 +99,11 @@ using microgradpp::Value;
          auto variables = microgradpp::utils::readVariablesFromJson("test_multiply_value_output.json");
 
          auto a = Value::create(64);
-         a->label = "a";
+         a->setLabel("a");
          auto b = Value::create(8);
-         b->label = "b";
+         b->setLabel("b");
          auto c = Value::multiply(a,b);
-         c->label = "c";
+         c->setLabel("c");
          c->backProp();
 
 
@@ -109,9 +120,9 @@ using microgradpp::Value;
          auto variables = microgradpp::utils::readVariablesFromJson("test_multiply_constant_output.json");
 
          auto a = Value::create(64);
-         a->label = "a";
+         a->setLabel("a");
          auto b = Value::multiply(a,8.90);
-         b->label = "b";
+         b->setLabel("b");
          b->backProp();
 
          microgradpp::GradTester::equals<float>(a->data, variables["a"].data, "testMultiplyConstant a data");
@@ -125,11 +136,11 @@ using microgradpp::Value;
          auto variables = microgradpp::utils::readVariablesFromJson("test_divide_value_output.json");
 
          auto a = Value::create(64);
-         a->label = "a";
+         a->setLabel("a");
          auto b = Value::create(8);
-         b->label = "b";
+         b->setLabel("b");
          auto c =  Value::divide(a,b);
-         c->label = "c";
+         c->setLabel("c");
          c->backProp();
 
 
@@ -146,9 +157,9 @@ using microgradpp::Value;
          auto variables = microgradpp::utils::readVariablesFromJson("test_divide_constant_output.json");
 
          auto a = Value::create(64);
-         a->label = "a";
+         a->setLabel("a");
          auto b =  Value::divide(a,8);
-         b->label = "b";
+         b->setLabel("b");
          b->backProp();
 
          microgradpp::GradTester::equals<float>(a->data, variables["a"].data, "testDivideConstant a data");
@@ -161,9 +172,9 @@ using microgradpp::Value;
          auto variables = microgradpp::utils::readVariablesFromJson("test_tanh_output.json");
 
          auto a = Value::create(7.89);
-         a->label = "a";
+         a->setLabel("a");
          auto b = Value::tanh(a);
-         b->label = "b";
+         b->setLabel("b");
          b->backProp();
          microgradpp::GradTester::equals<float>(a->data, variables["a"].data, "testTanh a data");
          microgradpp::GradTester::equals<float>(a->grad, variables["a"].grad, "testTanh a grad");
@@ -175,9 +186,9 @@ using microgradpp::Value;
          auto variables = microgradpp::utils::readVariablesFromJson("test_relu_output.json");
 
          auto a = Value::create(7.89);
-         a->label = "a";
+         a->setLabel("a");
          auto b = Value::relu(a);
-         b->label = "b";
+         b->setLabel("b");
          b->backProp();
          microgradpp::GradTester::equals<float>(a->data, variables["a"].data, "testRelu a data");
          microgradpp::GradTester::equals<float>(a->grad, variables["a"].grad, "testRelu a grad");
@@ -190,14 +201,14 @@ using microgradpp::Value;
          auto variables = microgradpp::utils::readVariablesFromJson("test_value_relu_long_output.json");
 
          auto a = Value::create(0.4);
-         a->label = "a";
+         a->setLabel("a");
          auto b = Value::create(0.03);
-         b->label = "b";
+         b->setLabel("b");
 
          auto c = Value::multiply(a,b);
-         c->label = "c";
+         c->setLabel("c");
          auto d = Value::relu(c);
-         d->label = "d";
+         d->setLabel("d");
          d->_backward();
          microgradpp::GradTester::equals<float>(a->data, variables["a"].data, "testRelu a data");
          microgradpp::GradTester::equals<float>(a->grad, variables["a"].grad, "testRelu a grad");
@@ -208,15 +219,944 @@ using microgradpp::Value;
          microgradpp::GradTester::equals<float>(d->data, variables["d"].data, "testRelu d data");
          microgradpp::GradTester::equals<float>(d->grad, variables["d"].grad, "testRelu d grad");
      }
+     // testNoGrad
+     {
+         auto a = Value::create(3);
+         auto b = Value::create(4);
+         const size_t tapeSize = microgradpp::Autograd::current().tape.size();
+         microgradpp::ValueRef c;
+         {
+             microgradpp::NoGradGuard guard;
+             c = Value::add(Value::multiply(a, b), 1.0f);
+         }
+         microgradpp::GradTester::equals<float>(c->data, 13.0f, "testNoGrad c data");
+         microgradpp::GradTester::equals<size_t>(microgradpp::Autograd::current().tape.size(), tapeSize, "testNoGrad tape size");
+         microgradpp::GradTester::equals<bool>(microgradpp::Autograd::isGradEnabled(), true, "testNoGrad mode restored");
+     }
+     // testPrunedBackward
+     {
+         auto a = Value::create(3);
+         auto b = Value::create(4);
+         auto c = Value::multiply(a, b);
+         auto side = Value::multiply(a, 5.0f); // not part of c's graph
+         side->grad = 1.0f;
+         c->backProp();
+         microgradpp::GradTester::equals<float>(a->grad, 4.0f, "testPrunedBackward a grad");
+         microgradpp::GradTester::equals<float>(b->grad, 3.0f, "testPrunedBackward b grad");
+     }
+     // testThreadLocalTape
+     {
+         auto a = Value::create(3);
+         auto b = Value::create(4);
+         const size_t tapeSize = microgradpp::Autograd::current().tape.size();
+         size_t workerTapeSize = 0;
+         float workerData = 0;
+         std::thread worker([&]() {
+             auto c = Value::multiply(a, b);
+             auto d = Value::add(c, a);
+             workerTapeSize = microgradpp::Autograd::current().tape.size();
+             workerData = d->data;
+         });
+         worker.join();
+         microgradpp::GradTester::equals<float>(workerData, 15.0f, "testThreadLocalTape worker data");
+         microgradpp::GradTester::equals<size_t>(workerTapeSize, 2, "testThreadLocalTape worker tape size");
+         microgradpp::GradTester::equals<size_t>(microgradpp::Autograd::current().tape.size(), tapeSize, "testThreadLocalTape main tape size");
+     }
+     // testParallelBackward
+     {
+         std::vector<microgradpp::ValuePtr> inputs;
+         for (int idx = 0; idx < 256; ++idx) {
+             inputs.push_back(Value::create(0.01f * idx));
+         }
+         auto build = [&inputs]() {
+             // Every term reads two inputs, so neighbouring terms add into the same gradient;
+             // a pairwise sum keeps the terms on one level of 256 records
+             std::vector<microgradpp::ValueRef> terms;
+             for (size_t idx = 0; idx < inputs.size(); ++idx) {
+                 terms.push_back(Value::tanh(Value::multiply(inputs[idx], inputs[(idx + 1) % inputs.size()])));
+             }
+             while (terms.size() > 1) {
+                 std::vector<microgradpp::ValueRef> sums;
+                 for (size_t idx = 0; idx < terms.size(); idx += 2) {
+                     sums.push_back(Value::add(terms[idx], terms[idx + 1]));
+                 }
+                 terms = std::move(sums);
+             }
+             return terms[0];
+         };
+         build()->backProp();
+         std::vector<float> expected;
+         for (auto& input : inputs) {
+             expected.push_back(input->grad);
+             input->grad = 0;
+         }
+         build()->backPropParallel();
+         float maxError = 0;
+         for (size_t idx = 0; idx < inputs.size(); ++idx) {
+             maxError = std::max(maxError, std::fabs(inputs[idx]->grad - expected[idx]));
+         }
+         microgradpp::GradTester::equals<bool>(maxError < 1e-6f, true, "testParallelBackward grads");
+     }
+     // testConstantOperand
+     {
+         auto a = Value::create(3);
+         auto& tape = microgradpp::Autograd::current();
+         const uint32_t nodes = tape.arena.size();
+         const size_t records = tape.tape.size();
+         auto b = Value::divide(Value::subtract(Value::multiply(Value::add(a, 1.0f), 4.0f), 2.0f), 2.0f);
+         b->backProp();
+         microgradpp::GradTester::equals<float>(b->data, 7.0f, "testConstantOperand b data");
+         microgradpp::GradTester::equals<float>(a->grad, 2.0f, "testConstantOperand a grad");
+         microgradpp::GradTester::equals<uint32_t>(tape.arena.size() - nodes, 4, "testConstantOperand nodes");
+         microgradpp::GradTester::equals<size_t>(tape.tape.size() - records, 4, "testConstantOperand records");
+     }
+     // testTapeOptimizer
+     {
+         auto a = Value::create(1.5f);
+         auto b = Value::create(-2.0f);
+         auto c = Value::create(0.5f);
+         auto& tape = microgradpp::Autograd::current();
+         auto build = [&]() {
+             auto z = Value::pow(Value::add(Value::multiply(a, 1.0f), 0.0f), 1.0f); // a
+             auto s = Value::add(Value::multiply(a, b), Value::multiply(b, a));      // CSE
+             Value::tanh(c);                                                         // dead
+             auto t = Value::add(Value::add(s, c), Value::multiply(z, c));           // SUM
+             return Value::add(t, Value::multiply(b, c));                            // SUM
+         };
+         auto gradients = [&]() {
+             std::vector<float> grads{a->grad, b->grad, c->grad};
+             a->grad = b->grad = c->grad = 0;
+             return grads;
+         };
+
+         const size_t begin = tape.tape.size();
+         auto expected = build();
+         expected->grad = 1.0f;
+         std::vector<microgradpp::TapeEntry> entries(tape.tape.begin() + begin, tape.tape.end());
+         tape.backward(entries, tape.operands);
+         const auto expectedGrads = gradients();
+
+         const size_t rebuilt = tape.tape.size();
+         auto root = build();
+         entries.assign(tape.tape.begin() + rebuilt, tape.tape.end());
+         std::vector<uint32_t> operands;
+         const auto stats = microgradpp::TapeOptimizer({root.index}).run(entries, operands);
+         root->data = 0;
+         tape.forward(entries, operands);
+         root->grad = 1.0f;
+         tape.backward(entries, operands);
+         const auto grads = gradients();
+
+         microgradpp::GradTester::equals<float>(root->data, expected->data, "testTapeOptimizer data");
+         microgradpp::GradTester::equals<float>(grads[0], expectedGrads[0], "testTapeOptimizer a grad");
+         microgradpp::GradTester::equals<float>(grads[1], expectedGrads[1], "testTapeOptimizer b grad");
+         microgradpp::GradTester::equals<float>(grads[2], expectedGrads[2], "testTapeOptimizer c grad");
+         microgradpp::GradTester::equals<size_t>(stats.simplified, 3, "testTapeOptimizer simplified");
+         microgradpp::GradTester::equals<size_t>(stats.merged, 1, "testTapeOptimizer merged");
+         microgradpp::GradTester::equals<size_t>(stats.dead, 1, "testTapeOptimizer dead");
+         microgradpp::GradTester::equals<size_t>(entries.size(), 4, "testTapeOptimizer records");
+
+         // Records the optimizer cannot see into are rejected, not rewritten
+         entries.push_back({microgradpp::OpCode::TENSOR, root.index, 0, microgradpp::Autograd::NONE, 0});
+         bool rejected = false;
+         try {
+             (void)microgradpp::TapeOptimizer({root.index}).run(entries, operands);
+         } catch (const std::logic_error&) {
+             rejected = true;
+         }
+         microgradpp::GradTester::equals<bool>(rejected && entries.size() == 5, true, "testTapeOptimizer rejects opaque records");
+     }
+     // testPlanCompiler
+     {
+         microgradpp::Tensor1D w(std::vector<float>{0.5f, -1.5f, 2.0f});
+         microgradpp::Tensor1D x(std::vector<float>{1.0f, 0.25f, -0.75f});
+         auto bias = Value::create(0.1f);
+         auto c = Value::create(0.3f);
+         auto& tape = microgradpp::Autograd::current();
+
+         const size_t begin = tape.tape.size();
+         auto d = Value::dot(w, x, bias);
+         auto e = Value::subtract(Value::tanh(d), Value::relu(Value::multiply(c, -2.0f)));
+         auto f = Value::add(Value::pow(Value::sigmoid(e), 2.0f), Value::multiply(d, c));
+         auto root = Value::add(Value::add(f, c), 0.5f);
+         std::vector<microgradpp::TapeEntry> entries(tape.tape.begin() + begin, tape.tape.end());
+
+         auto run = [&](auto&& replay) {
+             for (const auto& value : x) value->grad = 0;
+             for (const auto& value : w) value->grad = 0;
+             bias->grad = c->grad = 0;
+             for (const auto& entry : entries) tape.node(entry.out).grad = 0;
+             replay();
+             return std::vector<float>{root->data, w[1]->grad, x[2]->grad, bias->grad, c->grad};
+         };
+         const auto expected = run([&]() {
+             tape.forward(entries, tape.operands);
+             root->grad = 1.0f;
+             tape.backward(entries, tape.operands);
+         });
+
+         std::vector<uint32_t> nodes;
+         const auto native = microgradpp::PlanCompiler::load(microgradpp::PlanCompiler::generate(entries, tape.operands, nodes));
+         if (native) {
+             std::vector<void*> addresses;
+             for (const uint32_t index : nodes) addresses.push_back(&tape.node(index));
+             const auto actual = run([&]() {
+                 native.forward(addresses.data());
+                 root->grad = 1.0f;
+                 native.backward(addresses.data());
+             });
+             for (size_t idx = 0; idx < expected.size(); ++idx) {
+                 microgradpp::GradTester::equals<float>(actual[idx], expected[idx], "testPlanCompiler value " + std::to_string(idx));
+             }
+         } else {
+             std::cout << "testPlanCompiler skipped: no compiler available" << std::endl;
+         }
+     }
+     // testExpression
+     {
+         auto a = Value::create(0.75f);
+         auto b = Value::create(-1.25f);
+         auto c = Value::create(2.0f);
+         auto& tape = microgradpp::Autograd::current();
+         auto gradients = [&]() {
+             std::vector<float> grads{a->grad, b->grad, c->grad};
+             a->grad = b->grad = c->grad = 0;
+             return grads;
+         };
+
+         auto d = Value::subtract(a, b);
+         auto t = Value::tanh(Value::add(Value::multiply(a, c), b));
+         auto expected = Value::add(Value::subtract(Value::multiply(d, d), Value::multiply(t, 2.0f)),
+                                    Value::add(Value::divide(Value::pow(Value::sigmoid(c), 3.0f), 4.0f), Value::relu(b)));
+         expected->backProp();
+         const auto expectedGrads = gradients();
+
+         using namespace microgradpp::expr;
+         const size_t begin = tape.tape.size();
+         const auto e = var(a) - var(b);
+         auto fused = fuse(e * e - tanh(var(a) * var(c) + var(b)) * 2 + pow(sigmoid(var(c)), 3.0f) / 4 + relu(var(b)));
+         microgradpp::GradTester::equals<size_t>(tape.tape.size() - begin, 1, "testExpression records");
+         fused->backProp();
+         const auto grads = gradients();
+
+         microgradpp::GradTester::equals<float>(fused->data, expected->data, "testExpression data");
+         microgradpp::GradTester::equals<float>(grads[0], expectedGrads[0], "testExpression a grad");
+         microgradpp::GradTester::equals<float>(grads[1], expectedGrads[1], "testExpression b grad");
+         microgradpp::GradTester::equals<float>(grads[2], expectedGrads[2], "testExpression c grad");
+     }
+     // testScalarTypes
+     {
+         auto variables = microgradpp::utils::readVariablesFromJson("test_divide_value_output.json");
+
+         using Double = microgradpp::BasicValue<double>;
+         auto a = Double::create(64);
+         auto b = Double::create(8);
+         auto c = Double::divide(a, b);
+         c->backProp();
+         microgradpp::GradTester::equals<double>(a->grad, variables["a"].grad, "testScalarTypes double a grad");
+         microgradpp::GradTester::equals<double>(b->grad, variables["b"].grad, "testScalarTypes double b grad");
+         microgradpp::GradTester::equals<double>(c->data, variables["c"].data, "testScalarTypes double c data");
+
+         // bfloat16 keeps 8 significant bits: compare to the float results with a relative tolerance
+         using Half = microgradpp::BasicValue<microgradpp::bfloat16>;
+         auto x = Half::create(0.7f);
+         auto y = Half::create(-1.3f);
+         auto z = Half::tanh(Half::add(Half::multiply(x, y), Half::pow(x, 2)));
+         z->backProp();
+         auto fx = Value::create(x->data);
+         auto fy = Value::create(y->data);
+         auto fz = Value::tanh(Value::add(Value::multiply(fx, fy), Value::pow(fx, 2)));
+         fz->backProp();
+         auto close = [](float actual, float expected) { return std::abs(actual - expected) <= 1e-2f * std::abs(expected) + 1e-3f; };
+         microgradpp::GradTester::equals<size_t>(sizeof(Half), 12, "testScalarTypes bfloat16 node size");
+         microgradpp::GradTester::equals<bool>(close(z->data, fz->data), true, "testScalarTypes bfloat16 data");
+         microgradpp::GradTester::equals<bool>(close(x->grad, fx->grad), true, "testScalarTypes bfloat16 x grad");
+         microgradpp::GradTester::equals<bool>(close(y->grad, fy->grad), true, "testScalarTypes bfloat16 y grad");
+
+         // A double model trains on the same tape machinery
+         using namespace microgradpp;
+         core::BasicSequential<double> model({nn::Linear<double>(3, 8), nn::TanH<double>(), nn::Linear<double>(8, 1)});
+         BasicTensor2D<double> xs{{2, 3, -1}, {3, -1, 0.5}, {0.5, 1, 1}, {1, 1, -1}};
+         BasicTensor2D<double> ys{{1}, {-1}, {-1}, {1}};
+         loss::BasicMeanSquaredError<double> mse;
+         double first = 0, last = 0;
+         for (int it = 0; it < 100; ++it) {
+             BasicTensor2D<double> out;
+             for (const auto& row : xs) {
+                 out.push_back(model(row));
+             }
+             auto loss = mse(ys, out);
+             model.zeroGrad();
+             loss->backProp();
+             model.update(0.05);
+             (it == 0 ? first : last) = loss->data;
+             BasicAutograd<Double>::clear();
+         }
+         microgradpp::GradTester::equals<bool>(last < 1e-2 * first, true, "testScalarTypes double training");
+     }
+     // testForwardMode
+     {
+         using namespace microgradpp;
+         using D = Dual<float>;
+         using Dv = DualValue<float>;
+         auto& dualTape = BasicAutograd<Dv>::current();
+
+         // d/dx of sigmoid(x) * relu(x) / x^2 at x = 1.5
+         auto x = Dv::create(D(1.5f, 1.0f));
+         auto y = Dv::divide(Dv::multiply(Dv::sigmoid(x), Dv::relu(x)), Dv::pow(x, 2));
+         auto fx = Value::create(1.5f);
+         auto fy = Value::divide(Value::multiply(Value::sigmoid(fx), Value::relu(fx)), Value::pow(fx, 2));
+         fy->backProp();
+         microgradpp::GradTester::equals<float>(y->data.value, fy->data, "testForwardMode value");
+         microgradpp::GradTester::equals<float>(y->data.tangent, fx->grad, "testForwardMode derivative");
+         microgradpp::GradTester::equals<size_t>(dualTape.tape.size(), 0, "testForwardMode no records");
+
+         // Jacobian-vector product of a model against reverse mode
+         core::Sequential model({nn::Linear(3, 8), nn::TanH(), nn::Linear(8, 4), nn::ReLU(), nn::Linear(4, 2)});
+         core::BasicSequential<D> dual({nn::Linear<D>(3, 8), nn::TanH<D>(), nn::Linear<D>(8, 4), nn::ReLU<D>(), nn::Linear<D>(4, 2)});
+         copyParameters(model, dual);
+         const std::vector<float> point{0.3f, -0.7f, 1.1f}, direction{0.5f, 1.0f, -2.0f};
+         const uint32_t mark = dualTape.arena.size();
+         const auto product = jvp(dual, point, direction);
+         microgradpp::GradTester::equals<uint32_t>(dualTape.arena.size(), mark, "testForwardMode jvp releases nodes");
+         for (size_t out = 0; out < 2; ++out) {
+             microgradpp::Tensor1D in(point);
+             auto result = model(in);
+             result[out]->backProp();
+             float expected = 0;
+             for (size_t idx = 0; idx < point.size(); ++idx) {
+                 expected += in[idx]->grad * direction[idx];
+             }
+             microgradpp::GradTester::equals<float>(product.values[out], result[out]->data, "testForwardMode jvp value " + std::to_string(out));
+             microgradpp::GradTester::equals<float>(product.tangents[out], expected, "testForwardMode jvp tangent " + std::to_string(out));
+             Autograd::clear();
+         }
+
+         // Directional derivative of a loss
+         BasicTensor2D<D> xs;
+         DualTensor1D<float> row;
+         for (size_t idx = 0; idx < point.size(); ++idx) {
+             row.push_back(Dv::createTransient(D(point[idx], direction[idx])));
+         }
+         xs.push_back(row);
+         BasicTensor2D<D> ys{{D(1), D(-1)}};
+         BasicTensor2D<D> outputs;
+         outputs.push_back(dual(xs[0]));
+         loss::BasicMeanSquaredError<D> dualLoss;
+         auto lossValue = dualLoss(ys, outputs);
+
+         microgradpp::Tensor2D fxs{point};
+         microgradpp::Tensor2D fys{{1, -1}};
+         microgradpp::Tensor2D fouts;
+         fouts.push_back(model(fxs[0]));
+         loss::MeanSquaredError floatLoss;
+         auto expectedLoss = floatLoss(fys, fouts);
+         expectedLoss->backProp();
+         float expected = 0;
+         for (size_t idx = 0; idx < point.size(); ++idx) {
+             expected += fxs[0][idx]->grad * direction[idx];
+         }
+         microgradpp::GradTester::equals<float>(lossValue->data.value, expectedLoss->data, "testForwardMode loss value");
+         microgradpp::GradTester::equals<float>(lossValue->data.tangent, expected, "testForwardMode loss tangent");
+         microgradpp::GradTester::equals<size_t>(dualTape.tape.size(), 0, "testForwardMode loss no records");
+         BasicAutograd<Dv>::clear();
+         Autograd::clear();
+     }
+     // testReluMask
+     {
+         using namespace microgradpp;
+         auto& tape = Autograd::current();
+         std::vector<float> data;
+         for (int idx = 0; idx < 40; ++idx) {
+             data.push_back((idx % 3 == 0 ? -0.1f : 0.1f) * static_cast<float>(idx));
+         }
+         microgradpp::Tensor1D in(data);
+         auto build = [](const microgradpp::Tensor1D& activations) {
+             ValueRef sum = Value::multiply(activations[0], 1.0f);
+             for (size_t idx = 1; idx < activations.size(); ++idx) {
+                 sum = Value::add(sum, Value::multiply(activations[idx], 0.5f * static_cast<float>(idx)));
+             }
+             return sum;
+         };
+
+         // Reference: one RELU record per element
+         microgradpp::Tensor1D reference;
+         for (const auto& x : in) {
+             reference.push_back(Value::relu(x));
+         }
+         build(reference)->backProp();
+         std::vector<float> expected;
+         for (const auto& x : in) {
+             expected.push_back(x->grad);
+             x->grad = 0;
+         }
+         Autograd::clear();
+
+         core::CoreReLU layer;
+         auto out = layer(in);
+         microgradpp::GradTester::equals<size_t>(tape.tape.size(), 1, "testReluMask one record");
+         microgradpp::GradTester::equals<size_t>(tape.operands.size(), 2 * 40 + 2, "testReluMask operand slots");
+         size_t mismatches = 0;
+         for (size_t idx = 0; idx < data.size(); ++idx) {
+             mismatches += out[idx]->data != std::max(0.0f, data[idx]);
+         }
+         microgradpp::GradTester::equals<size_t>(mismatches, 0, "testReluMask outputs");
+
+         auto root = build(out);
+         for (const auto& value : out) {
+             value->data = 0; // Backward reads the mask, not the outputs
+         }
+         root->backProp();
+         mismatches = 0;
+         for (size_t idx = 0; idx < data.size(); ++idx) {
+             mismatches += in[idx]->grad != expected[idx];
+             in[idx]->grad = 0;
+         }
+         microgradpp::GradTester::equals<size_t>(mismatches, 0, "testReluMask grads");
+         Autograd::clear();
+     }
+     // testSparseBackward
+     {
+         using namespace microgradpp;
+         auto& tape = Autograd::current();
+
+         // A dead ReLU ends the walk: the product feeding it is never reached
+         auto a = Value::create(-2.0f);
+         auto b = Value::create(3.0f);
+         auto y = Value::add(Value::relu(Value::multiply(a, b)), Value::multiply(b, b));
+         y->backProp();
+         microgradpp::GradTester::equals<float>(a->grad, 0.0f, "testSparseBackward a grad");
+         microgradpp::GradTester::equals<float>(b->grad, 6.0f, "testSparseBackward b grad");
+         microgradpp::GradTester::equals<size_t>(tape.stats.executed, 2, "testSparseBackward executed");
+         microgradpp::GradTester::equals<size_t>(tape.stats.skipped, 1, "testSparseBackward skipped");
+         microgradpp::GradTester::equals<size_t>(tape.stats.skippedOperands, 1, "testSparseBackward skipped operands");
+         Autograd::clear();
+
+         // Same gradients with and without skipping on a network with dead units
+         core::Sequential model({nn::Linear(4, 16), nn::ReLU(), nn::Linear(16, 16), nn::ReLU(), nn::Linear(16, 1)});
+         microgradpp::Tensor1D in(std::vector<float>{0.5f, -1.0f, 0.25f, 2.0f});
+         auto out = model(in)[0];
+         out->backProp();
+         const BackwardStats pruned = tape.stats;
+         std::vector<float> grads;
+         for (const auto& param : model.parameters()) {
+             grads.push_back(param->grad);
+         }
+         Autograd::clear();
+         model.zeroGrad();
+         out = model(in)[0];
+         out->grad = 1;
+         tape.backward();
+         microgradpp::GradTester::equals<size_t>(tape.stats.executed + tape.stats.skipped, tape.tape.size(), "testSparseBackward full walk counts every record");
+         microgradpp::GradTester::equals<bool>(pruned.executed + pruned.skipped < tape.tape.size(), true, "testSparseBackward network dead units not reached");
+         const auto params = model.parameters();
+         size_t mismatches = 0;
+         for (size_t idx = 0; idx < params.size(); ++idx) {
+             mismatches += std::abs(params[idx]->grad - grads[idx]) > 1e-6f;
+         }
+         microgradpp::GradTester::equals<size_t>(mismatches, 0, "testSparseBackward network grads");
+         Autograd::clear();
+         model.zeroGrad();
+     }
+     // testGradientAccumulation
+     {
+         using namespace microgradpp;
+         auto& tape = Autograd::current();
+         core::Sequential model({nn::Linear(3, 6), nn::TanH(), nn::Linear(6, 2)});
+         microgradpp::Tensor2D xs = {{0.5, -1.0, 0.25}, {1.5, 0.5, -0.5}, {-0.25, 0.75, 1.0}, {0.0, -0.5, 2.0}};
+         microgradpp::Tensor2D ys = {{1.0, 0.0}, {-1.0, 0.5}, {0.25, 0.25}, {0.0, -1.0}};
+         loss::MeanSquaredError lossFcn;
+
+         // Whole batch on one tape
+         microgradpp::Tensor2D predictions;
+         for (const auto& input : xs) {
+             predictions.push_back(model(input));
+         }
+         auto total = lossFcn(ys, predictions);
+         model.zeroGrad();
+         total->backProp();
+         std::vector<float> expected;
+         for (const auto& param : model.parameters()) {
+             expected.push_back(param->grad);
+         }
+         const float expectedLoss = total->data;
+         Autograd::clear();
+
+         // Two micro-batches of two samples
+         model.zeroGrad();
+         const auto start = tape.position();
+         float accumulated = 0;
+         for (size_t first = 0; first < xs.size(); first += 2) {
+             microgradpp::Tensor2D xBatch, yBatch;
+             for (size_t idx = first; idx < first + 2; ++idx) {
+                 xBatch.push_back(xs[idx]);
+                 yBatch.push_back(ys[idx]);
+             }
+             accumulated += model.accumulate(xBatch, yBatch, lossFcn);
+             microgradpp::GradTester::equals<size_t>(tape.tape.size(), start.records, "testGradientAccumulation tape rewound");
+             microgradpp::GradTester::equals<uint32_t>(tape.arena.size(), start.nodes, "testGradientAccumulation nodes released");
+         }
+         size_t mismatches = 0;
+         const auto params = model.parameters();
+         for (size_t idx = 0; idx < params.size(); ++idx) {
+             mismatches += std::abs(params[idx]->grad - expected[idx]) > 1e-5f;
+         }
+         microgradpp::GradTester::equals<float>(accumulated, expectedLoss, "testGradientAccumulation loss");
+         microgradpp::GradTester::equals<size_t>(mismatches, 0, "testGradientAccumulation grads");
+         model.zeroGrad();
+     }
+     // testCheckpointing
+     {
+         using namespace microgradpp;
+         auto& tape = Autograd::current();
+         loss::MeanSquaredError lossFcn;
+         microgradpp::Tensor2D xs = {{0.5, -1.0, 0.25}, {1.5, 0.5, -0.5}, {-0.25, 0.75, 1.0}};
+         microgradpp::Tensor2D ys = {{1.0, 0.0}, {-1.0, 0.5}, {0.25, 0.25}};
+         auto makeModel = []() {
+             return core::Sequential({nn::Linear(3, 6), nn::TanH(), nn::Linear(6, 6), nn::ReLU(), nn::Linear(6, 2)});
+         };
+         core::Sequential reference = makeModel();
+         const auto expectedParams = reference.parameters();
+
+         // Loss and parameter grads of one eager pass; the tape is checked to be back where
+         // the forward pass left it once the checkpointed segments have been back-propagated
+         size_t restored = 0;
+         auto run = [&](core::Sequential& model) {
+             model.zeroGrad();
+             microgradpp::Tensor2D predictions;
+             for (const auto& input : xs) {
+                 predictions.push_back(model(input));
+             }
+             auto total = lossFcn(ys, predictions);
+             const auto forward = tape.position();
+             total->backProp();
+             const auto backward = tape.position();
+             restored += backward.records == forward.records && backward.operands == forward.operands &&
+                         backward.checkpoints == forward.checkpoints && backward.nodes == forward.nodes;
+             std::vector<float> result{total->data};
+             for (const auto* param : model.parameters()) {
+                 result.push_back(param->grad);
+             }
+             Autograd::clear();
+             model.zeroGrad();
+             return result;
+         };
+         const auto expected = run(reference);
+
+         size_t mismatches = 0;
+         for (const size_t layersPerSegment : {1, 2}) {
+             core::Sequential model = makeModel();
+             const auto params = model.parameters();
+             for (size_t idx = 0; idx < params.size(); ++idx) {
+                 params[idx]->data = expectedParams[idx]->data;
+             }
+             model.setCheckpointing(layersPerSegment);
+             const auto actual = run(model);
+             for (size_t idx = 0; idx < actual.size(); ++idx) {
+                 mismatches += std::fabs(actual[idx] - expected[idx]) > 1e-5f;
+             }
+
+             // Segments are not recorded while capturing, so the plan replays the plain pass
+             GraphPlan plan = GraphPlan::capture(model, xs, ys, lossFcn);
+             mismatches += std::fabs(plan.forward(xs, ys) - expected[0]) > 1e-5f;
+             plan.backward();
+             for (size_t idx = 0; idx < params.size(); ++idx) {
+                 mismatches += std::fabs(params[idx]->grad - expected[idx + 1]) > 1e-5f;
+             }
+             Autograd::clear();
+             model.zeroGrad();
+         }
+         microgradpp::GradTester::equals<size_t>(mismatches, 0, "testCheckpointing matches the plain pass");
+         microgradpp::GradTester::equals<size_t>(restored, 3, "testCheckpointing tape restored after backward");
+     }
+     // testGraphPlan
+     {
+         using namespace microgradpp;
+         auto& tape = Autograd::current();
+         core::Sequential model({nn::Linear(3, 5), nn::TanH(), nn::Linear(5, 2)});
+         loss::MeanSquaredError lossFcn;
+         microgradpp::Tensor2D xs = {{0.5, -1.0, 0.25}, {1.5, 0.5, -0.5}};
+         microgradpp::Tensor2D ys = {{1.0, 0.0}, {-1.0, 0.5}};
+         GraphPlan plan = GraphPlan::capture(model, xs, ys, lossFcn);
+         Autograd::clear();
+
+         // Each replay matches an eager pass over the same data and creates no nodes
+         const auto params = model.parameters();
+         const microgradpp::Tensor2D batches[][2] = {{{{-0.25, 0.75, 1.0}, {0.0, -0.5, 2.0}}, {{0.25, 0.25}, {0.0, -1.0}}},
+                                                     {{{2.0, 0.1, -1.5}, {-0.75, 0.5, 0.5}}, {{-0.5, 1.0}, {0.75, 0.25}}}};
+         size_t mismatches = 0;
+         for (const auto& batch : batches) {
+             model.zeroGrad();
+             microgradpp::Tensor2D predictions;
+             for (const auto& input : batch[0]) {
+                 predictions.push_back(model(input));
+             }
+             auto eager = lossFcn(batch[1], predictions);
+             eager->backProp();
+             const float expectedLoss = eager->data;
+             std::vector<float> expected;
+             for (const auto* param : params) {
+                 expected.push_back(param->grad);
+             }
+             Autograd::clear();
+
+             model.zeroGrad();
+             const auto start = tape.position();
+             const float replayed = plan.forward(batch[0], batch[1]);
+             plan.backward();
+             mismatches += std::fabs(replayed - expectedLoss) > 1e-5f;
+             for (size_t idx = 0; idx < params.size(); ++idx) {
+                 mismatches += std::fabs(params[idx]->grad - expected[idx]) > 1e-5f;
+             }
+             mismatches += tape.tape.size() != start.records;
+             mismatches += tape.arena.size() != start.nodes;
+         }
+         microgradpp::GradTester::equals<size_t>(mismatches, 0, "testGraphPlan replays");
+
+         // A failed capture leaves nothing on the tape
+         const auto start = tape.position();
+         bool rejected = false;
+         try {
+             auto failing = [&model](const microgradpp::Tensor1D& input) {
+                 (void)model(input);
+                 throw std::runtime_error("failing model");
+                 return microgradpp::Tensor1D();
+             };
+             (void)GraphPlan::capture(failing, xs, ys, lossFcn);
+         } catch (const std::runtime_error&) {
+             rejected = true;
+         }
+         const auto end = tape.position();
+         microgradpp::GradTester::equals<bool>(rejected && end.records == start.records && end.operands == start.operands &&
+                                               end.tensorOps == start.tensorOps && end.nodes == start.nodes, true, "testGraphPlan failed capture");
+         model.zeroGrad();
+     }
+     // testDenseTensor
+     {
+         using namespace microgradpp;
+         auto& tape = Autograd::current();
+         DenseTensor x({2, 3}, std::vector<float>{1, 2, 3, 4, 5, 6});
+         DenseTensor w({3, 2}, std::vector<float>{0.5f, -1, 2, 0.25f, -0.5f, 1.5f});
+         const size_t records = tape.tape.size();
+         auto y = DenseTensor::matmul(x, w);
+         auto loss = DenseTensor::sum(y);
+         microgradpp::GradTester::equals<size_t>(tape.tape.size() - records, 2, "testDenseTensor one record per op");
+         microgradpp::GradTester::equals<float>(y.at({1, 0}), 4 * 0.5f + 5 * 2 + 6 * -0.5f, "testDenseTensor matmul value");
+         loss.backward();
+         microgradpp::GradTester::equals<float>(w.gradAt({1, 0}), 2 + 5, "testDenseTensor matmul w grad");
+         microgradpp::GradTester::equals<float>(x.gradAt({0, 2}), -0.5f + 1.5f, "testDenseTensor matmul x grad");
+         Autograd::clear();
+
+         // A transposed view shares its buffers with the tensor it views
+         DenseTensor wt({2, 3}, std::vector<float>{0.5f, 2, -0.5f, -1, 0.25f, 1.5f});
+         x.zeroGrad();
+         DenseTensor::sum(DenseTensor::matmul(x, wt.transpose())).backward();
+         microgradpp::GradTester::equals<float>(wt.gradAt({0, 1}), 2 + 5, "testDenseTensor transposed grad");
+         microgradpp::GradTester::equals<float>(x.gradAt({0, 2}), -0.5f + 1.5f, "testDenseTensor transposed x grad");
+         Autograd::clear();
+
+         // d/da sum((a + b) * a) = 2a + b, d/db = a
+         DenseTensor a({4}, std::vector<float>{1, -2, 3, 0.5f});
+         DenseTensor b({2, 2}, std::vector<float>{2, 1, -1, 4});
+         DenseTensor::sum(DenseTensor::multiply(DenseTensor::add(a.reshape({2, 2}), b), a.reshape({2, 2}))).backward();
+         microgradpp::GradTester::equals<float>(a.gradAt({1}), 2 * -2 + 1, "testDenseTensor elementwise a grad");
+         microgradpp::GradTester::equals<float>(b.gradAt({1, 1}), 0.5f, "testDenseTensor elementwise b grad");
+         Autograd::clear();
+
+         // Node tensors to dense and back, gradients crossing both conversions
+         microgradpp::Tensor2D nodes = {{1, 2}, {3, 4}};
+         auto dense = DenseTensor::from(nodes);
+         auto rows = DenseTensor::multiply(dense, dense).toTensor2D();
+         auto total = Value::add(Value::add(rows[0][0], rows[0][1]), Value::add(rows[1][0], rows[1][1]));
+         total->backProp();
+         microgradpp::GradTester::equals<float>(total->data, 30.0f, "testDenseTensor conversions value");
+         microgradpp::GradTester::equals<float>(nodes[1][0]->grad, 6.0f, "testDenseTensor conversions grad");
+         Autograd::clear();
+     }
+     // testArena
+     {
+         using namespace microgradpp;
+         auto& tape = Autograd::current();
+         Autograd::clear();
+         for (int idx = 0; idx < 5000; ++idx) {
+             (void)Value::createTransient(static_cast<float>(idx));
+         }
+         const size_t capacity = tape.arena.capacity();
+         Autograd::clear();
+         microgradpp::GradTester::equals<bool>(tape.arena.size() == 0 && tape.arena.capacity() == capacity, true,
+                                               "testArena clear keeps blocks");
+
+         // A released slot is handed out again once the tape no longer refers to it
+         uint32_t released;
+         {
+             auto value = Value::create(1.0f);
+             released = value->index;
+         }
+         Autograd::clear();
+         auto reused = Value::create(2.0f);
+         microgradpp::GradTester::equals<uint32_t>(reused->index, released, "testArena pool reuses slots");
+
+         auto kept = Value::create(3.0f);
+         (void)Value::add(kept, reused);
+         Autograd::clear();
+         microgradpp::GradTester::equals<float>(kept->data + reused->data, 5.0f, "testArena persistent survives clear");
+     }
+
+     // testTensorView
+     {
+         using namespace microgradpp;
+         Tensor2D xs = {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}};
+         const TensorView row = xs.row(1);
+         microgradpp::GradTester::equals<uint32_t>(row[2].index, xs.at(1, 2).index, "testTensorView row shares nodes");
+         const TensorView odd = row.slice(1, 2, 2);
+         microgradpp::GradTester::equals<float>(odd[0]->data + odd[1]->data, 6 + 8, "testTensorView strided slice");
+         float columnSum = 0;
+         for (const auto& value : xs.column(2)) {
+             columnSum += value->data;
+         }
+         microgradpp::GradTester::equals<float>(columnSum, 3 + 7 + 11, "testTensorView column");
+
+         // A model run on a view gives the same value and gradients as on a copy of the row
+         core::Sequential model({nn::Linear(4, 3), nn::ReLU(), nn::Linear(3, 1)});
+         auto fromView = model(xs.row(2));
+         fromView[0]->backProp();
+         const float viewGrad = xs.at(2, 0)->grad;
+         xs.zeroGrad();
+         Tensor1D copy(xs.row(2));
+         auto fromCopy = model(copy);
+         fromCopy[0]->backProp();
+         microgradpp::GradTester::equals<float>(fromView[0]->data, fromCopy[0]->data, "testTensorView model value");
+         microgradpp::GradTester::equals<float>(viewGrad, xs.at(2, 0)->grad, "testTensorView model grad");
+         Autograd::clear();
+
+         // A tensor built from a view keeps the viewed nodes alive once the source is gone
+         Tensor1D passed;
+         {
+             Tensor2D rows = {{2.5f, -1}};
+             core::Sequential identity(std::vector<std::shared_ptr<core::MppCore>>{});
+             passed = identity(rows.row(0));
+         }
+         Autograd::clear();
+         Tensor2D reused = {{-7, -7}};
+         microgradpp::GradTester::equals<float>(passed[0]->data + passed[1]->data, 1.5f, "testTensorView keeps owners");
+     }
+
+     // testBulkTensor
+     {
+         using namespace microgradpp;
+         const std::vector<float> buffer = {1, 2, 3, 4, 5, 6};
+         Tensor2D xs(buffer.data(), 2, 3);
+         size_t mismatches = 0;
+         for (size_t idx = 0; idx < buffer.size(); ++idx) {
+             mismatches += xs.at(idx / 3, idx % 3)->data != buffer[idx];
+         }
+         microgradpp::GradTester::equals<size_t>(mismatches, 0, "testBulkTensor values");
+
+         // A block takes consecutive pool slots, which the next block reuses once released
+         uint32_t first;
+         {
+             Tensor2D scratch(buffer.data(), 2, 3);
+             first = scratch.at(0, 0).index;
+             mismatches += scratch.at(1, 2).index != first + 5;
+         }
+         Autograd::clear();
+         Tensor2D again(buffer.data(), 2, 3);
+         microgradpp::GradTester::equals<bool>(mismatches == 0 && again.at(0, 0).index == first, true,
+                                               "testBulkTensor consecutive slots");
+         Tensor2D ragged = {{1}, {2, 3}};
+         microgradpp::GradTester::equals<float>(ragged.at(1, 1)->data + ragged[0].size(), 3 + 1, "testBulkTensor ragged rows");
+
+         // An adopted buffer is used in place until its guard lets go of it
+         std::vector<float> pixels = {0.5f, 1.5f, 2.5f, 3.5f};
+         DenseTensor copied = DenseTensor::copy(pixels.data(), {2, 2});
+         DenseTensor adopted;
+         {
+             DenseBufferGuard guard;
+             adopted = DenseTensor::adopt(pixels.data(), {2, 2}, guard);
+             pixels[3] = 7;
+             microgradpp::GradTester::equals<float>(adopted.at({1, 1}), 7, "testBulkTensor adopt shares buffer");
+         }
+         pixels[3] = -1;
+         microgradpp::GradTester::equals<float>(adopted.at({1, 1}) + copied.at({1, 1}), 7 + 3.5f, "testBulkTensor guard detaches");
+     }
+
+     // testBroadcasting
+     {
+         using namespace microgradpp;
+         size_t mismatches = 0;
+         const auto near = [&mismatches](float actual, float expected) {
+             mismatches += std::fabs(actual - expected) > 1e-4f * (1 + std::fabs(expected));
+         };
+
+         // Bias add: {2, 3} + {3}; the bias gradient sums over the batch
+         DenseTensor x({2, 3}, std::vector<float>{1, 2, 3, 4, 5, 6});
+         DenseTensor bias({3}, std::vector<float>{0.5f, -1, 2});
+         DenseTensor::sum(DenseTensor::multiply(DenseTensor::add(x, bias), x)).backward();
+         near(x.gradAt({1, 2}), 2 * 6 + 2);
+         near(bias.gradAt({1}), 2 + 5);
+         Autograd::clear();
+
+         // {2, 1} - {3} broadcasts both operands to {2, 3}
+         DenseTensor column({2, 1}, std::vector<float>{1, 2});
+         DenseTensor row({3}, std::vector<float>{3, 4, 5});
+         auto difference = DenseTensor::subtract(column, row);
+         near(difference.at({1, 0}), 2 - 3);
+         DenseTensor::sum(difference).backward();
+         near(column.gradAt({0, 0}), 3);
+         near(row.gradAt({2}), -2);
+         Autograd::clear();
+
+         // d/dy sum(x / y) = -sum_i x_ij / y_j^2 for y of shape {3}
+         x.zeroGrad();
+         DenseTensor y({3}, std::vector<float>{2, 4, -1});
+         DenseTensor::sum(DenseTensor::divide(x, y)).backward();
+         near(y.gradAt({1}), -(2 + 5) / 16.0f);
+         near(x.gradAt({0, 2}), -1);
+         Autograd::clear();
+
+         // Tensor exponent broadcast from {1}
+         DenseTensor base({2}, std::vector<float>{2, 3});
+         DenseTensor exponent({1}, 3.0f);
+         DenseTensor::sum(DenseTensor::pow(base, exponent)).backward();
+         near(base.gradAt({1}), 3 * 9);
+         near(exponent.gradAt({0}), 8 * std::log(2.0f) + 27 * std::log(3.0f));
+         Autograd::clear();
+
+         // Activations against their scalar derivatives
+         DenseTensor a({3}, std::vector<float>{-0.5f, 0.25f, 1.5f});
+         DenseTensor::sum(DenseTensor::add(DenseTensor::add(DenseTensor::tanh(a), DenseTensor::relu(a)),
+                                           DenseTensor::sigmoid(a))).backward();
+         for (size_t idx = 0; idx < 3; ++idx) {
+             const float v = a.at({idx});
+             const float s = 1 / (1 + std::exp(-v));
+             near(a.gradAt({idx}), 1 - std::tanh(v) * std::tanh(v) + (v > 0 ? 1.0f : 0.0f) + s * (1 - s));
+         }
+         Autograd::clear();
+         microgradpp::GradTester::equals<size_t>(mismatches, 0, "testBroadcasting gradients");
+
+         bool thrown = false;
+         try {
+             (void)DenseTensor::add(DenseTensor({2, 3}), DenseTensor({2}));
+         } catch (const std::invalid_argument&) {
+             thrown = true;
+         }
+         microgradpp::GradTester::equals<bool>(thrown, true, "testBroadcasting incompatible shapes");
+         Autograd::clear();
+     }
+
+     // testGemm
+     {
+         using namespace microgradpp;
+         namespace gemm = microgradpp::gemm;
+
+         // Every kernel the CPU supports against a naive product, for the NN, NT and TN
+         // variants and sizes that leave partial tiles and blocks
+         const size_t m = 37, n = 45, k = 300;
+         std::vector<float> a(m * k), b(k * n);
+         for (size_t idx = 0; idx < a.size(); ++idx) {
+             a[idx] = std::sin(0.1f * static_cast<float>(idx));
+         }
+         for (size_t idx = 0; idx < b.size(); ++idx) {
+             b[idx] = std::cos(0.07f * static_cast<float>(idx));
+         }
+         size_t mismatches = 0;
+         for (const auto kernel : {gemm::Kernel::PORTABLE, gemm::Kernel::AVX2, gemm::Kernel::AVX512}) {
+             if (!gemm::supported(kernel)) {
+                 continue;
+             }
+             for (const auto& [transposeA, transposeB] : {std::pair{false, false}, {false, true}, {true, false}}) {
+                 // A is {m, k} or, transposed, stored as {k, m}; likewise B
+                 const size_t lda = transposeA ? m : k, ldb = transposeB ? k : n;
+                 std::vector<float> c(m * n, 1.0f);
+                 gemm::sgemm(transposeA, transposeB, m, n, k, a.data(), lda, b.data(), ldb, c.data(), n, kernel);
+                 for (size_t row = 0; row < m; ++row) {
+                     for (size_t col = 0; col < n; ++col) {
+                         double expected = 1;
+                         for (size_t p = 0; p < k; ++p) {
+                             expected += static_cast<double>(transposeA ? a[p * lda + row] : a[row * lda + p]) *
+                                         (transposeB ? b[col * ldb + p] : b[p * ldb + col]);
+                         }
+                         mismatches += std::fabs(c[row * n + col] - expected) > 1e-3 * (1 + std::fabs(expected));
+                     }
+                 }
+             }
+         }
+         microgradpp::GradTester::equals<size_t>(mismatches, 0, "testGemm kernels");
+
+         // A batched Linear layer matches the same layer applied row by row
+         core::CoreLinear linear(5, 4);
+         std::vector<float> raw(3 * 5);
+         for (size_t idx = 0; idx < raw.size(); ++idx) {
+             raw[idx] = std::sin(static_cast<float>(idx));
+         }
+         Tensor2D xs(raw.data(), 3, 5);
+         const auto params = linear.parameters();
+         std::vector<float> rowOutputs, rowGrads;
+         for (const bool batched : {false, true}) {
+             linear.zeroGrad();
+             xs.zeroGrad();
+             Tensor2D ys;
+             if (batched) {
+                 ys = linear.forwardBatch(xs);
+             } else {
+                 for (const auto& row : xs) {
+                     ys.push_back(linear(row));
+                 }
+             }
+             Value::Ref loss = Value::createTransient(0);
+             for (size_t row = 0; row < 3; ++row) {
+                 for (size_t col = 0; col < 4; ++col) {
+                     loss = Value::add(loss, Value::multiply(ys[row][col], static_cast<float>(row + col)));
+                 }
+             }
+             loss->backProp();
+             std::vector<float> outputs, grads;
+             for (const auto& row : ys) {
+                 for (const auto& value : row) {
+                     outputs.push_back(value->data);
+                 }
+             }
+             for (const auto* param : params) {
+                 grads.push_back(param->grad);
+             }
+             for (const auto& row : xs) {
+                 for (const auto& value : row) {
+                     grads.push_back(value->grad);
+                 }
+             }
+             if (!batched) {
+                 rowOutputs = outputs;
+                 rowGrads = grads;
+             } else {
+                 mismatches = 0;
+                 for (size_t idx = 0; idx < outputs.size(); ++idx) {
+                     mismatches += std::fabs(outputs[idx] - rowOutputs[idx]) > 1e-5f;
+                 }
+                 for (size_t idx = 0; idx < grads.size(); ++idx) {
+                     mismatches += std::fabs(grads[idx] - rowGrads[idx]) > 1e-4f;
+                 }
+             }
+             Autograd::clear();
+         }
+         microgradpp::GradTester::equals<size_t>(mismatches, 0, "testGemm batched Linear");
+         {
+             // Nothing is recorded in inference mode, so the outputs are plain leaves
+             NoGradGuard guard;
+             const auto ys = linear.forwardBatch(xs);
+             microgradpp::GradTester::equals<bool>(ys[0][0]->op == OpCode::LEAF, true, "testGemm inference leaves");
+         }
+         Autograd::clear();
+     }
+
      // testPlusEquals
      // TODO
 //     {
 //         auto variables = microgradpp::utils::readVariablesFromJson("test_plus_equals_output.json");
 //
 //         auto a = Value::create(64);
-//         a->label = "a";
+//         a->setLabel("a");
 //         auto b = Value::create(4.89);
-//         b->label = "b";
+//         b->setLabel("b");
 //         b += a;
 //         b->backProp();
 //         microgradpp::GradTester::equals<float>(a->data, variables["a"].data, "testPlusEquals a data");
@@ -231,9 +1171,9 @@ using microgradpp::Value;
 //         auto variables = microgradpp::utils::readVariablesFromJson("test_multiply_equals_output.json");
 //
 //         auto a = Value::create(64);
-//         a->label = "a";
+//         a->setLabel("a");
 //         auto b = Value::create(4.89);
-//         b->label = "b";
+//         b->setLabel("b");
 //         b *= a;
 //         b->backProp();
 //         microgradpp::GradTester::equals<float>(a->data, variables["a"].data, "testMultiplyEquals a data");